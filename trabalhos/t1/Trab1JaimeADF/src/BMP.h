@@ -36,31 +36,42 @@ namespace yap
                 throw std::runtime_error("Unable to open BMP file");
             }
 
+            uint8_t headerData[HeaderSize + MaxInfoHeaderSize] = {};
+
+            file.read(reinterpret_cast<char*>(headerData), HeaderSize + InfoHeaderSize);
+
+            if (!file)
+            {
+                throw std::runtime_error("Invalid BMP file format");
+            }
+
             Header header;
             InfoHeader infoHeader;
 
-            file.read(reinterpret_cast<char*>(&header.Type), sizeof(header.Type));
-            file.read(reinterpret_cast<char*>(&header.Size), sizeof(header.Size));
-            file.read(reinterpret_cast<char*>(&header.Reserved1), sizeof(header.Reserved1));
-            file.read(reinterpret_cast<char*>(&header.Reserved2), sizeof(header.Reserved2));
-            file.read(reinterpret_cast<char*>(&header.Offset), sizeof(header.Offset));
+            header.Type = ReadLittleEndian<uint16_t>(headerData, 0);
+            header.Size = ReadLittleEndian<uint32_t>(headerData, 2);
+            header.Reserved1 = ReadLittleEndian<uint16_t>(headerData, 6);
+            header.Reserved2 = ReadLittleEndian<uint16_t>(headerData, 8);
+            header.Offset = ReadLittleEndian<uint32_t>(headerData, 10);
 
             if (header.Type != 0x4D42)
             {
                 throw std::runtime_error("Invalid BMP file format");
             }
 
-            file.read(reinterpret_cast<char*>(&infoHeader.Size), sizeof(infoHeader.Size));
-            file.read(reinterpret_cast<char*>(&infoHeader.Width), sizeof(infoHeader.Width));
-            file.read(reinterpret_cast<char*>(&infoHeader.Height), sizeof(infoHeader.Height));
-            file.read(reinterpret_cast<char*>(&infoHeader.Planes), sizeof(infoHeader.Planes));
-            file.read(reinterpret_cast<char*>(&infoHeader.BitsPerPixel), sizeof(infoHeader.BitsPerPixel));
-            file.read(reinterpret_cast<char*>(&infoHeader.Compression), sizeof(infoHeader.Compression));
-            file.read(reinterpret_cast<char*>(&infoHeader.ImageSize), sizeof(infoHeader.ImageSize));
-            file.read(reinterpret_cast<char*>(&infoHeader.XPixelsPerMeter), sizeof(infoHeader.XPixelsPerMeter));
-            file.read(reinterpret_cast<char*>(&infoHeader.YPixelsPerMeter), sizeof(infoHeader.YPixelsPerMeter));
-            file.read(reinterpret_cast<char*>(&infoHeader.ColorUsed), sizeof(infoHeader.ColorUsed));
-            file.read(reinterpret_cast<char*>(&infoHeader.ColorImportant), sizeof(infoHeader.ColorImportant));
+            const uint8_t* infoHeaderData = headerData + HeaderSize;
+
+            infoHeader.Size = ReadLittleEndian<uint32_t>(infoHeaderData, 0);
+            infoHeader.Width = ReadLittleEndian<int32_t>(infoHeaderData, 4);
+            infoHeader.Height = ReadLittleEndian<int32_t>(infoHeaderData, 8);
+            infoHeader.Planes = ReadLittleEndian<uint16_t>(infoHeaderData, 12);
+            infoHeader.BitsPerPixel = ReadLittleEndian<uint16_t>(infoHeaderData, 14);
+            infoHeader.Compression = ReadLittleEndian<uint32_t>(infoHeaderData, 16);
+            infoHeader.ImageSize = ReadLittleEndian<uint32_t>(infoHeaderData, 20);
+            infoHeader.XPixelsPerMeter = ReadLittleEndian<int32_t>(infoHeaderData, 24);
+            infoHeader.YPixelsPerMeter = ReadLittleEndian<int32_t>(infoHeaderData, 28);
+            infoHeader.ColorUsed = ReadLittleEndian<uint32_t>(infoHeaderData, 32);
+            infoHeader.ColorImportant = ReadLittleEndian<uint32_t>(infoHeaderData, 36);
 
             if (infoHeader.BitsPerPixel != 24 && infoHeader.BitsPerPixel != 32)
             {
@@ -86,10 +97,12 @@ namespace yap
             {
                 if (infoHeader.Compression == 3)
                 {
-                    file.read(reinterpret_cast<char*>(&infoHeader.RedMask), sizeof(infoHeader.RedMask));
-                    file.read(reinterpret_cast<char*>(&infoHeader.GreenMask), sizeof(infoHeader.GreenMask));
-                    file.read(reinterpret_cast<char*>(&infoHeader.BlueMask), sizeof(infoHeader.BlueMask));
-                    file.read(reinterpret_cast<char*>(&infoHeader.AlphaMask), sizeof(infoHeader.AlphaMask));
+                    file.read(reinterpret_cast<char*>(headerData + HeaderSize + InfoHeaderSize), 16);
+
+                    infoHeader.RedMask = ReadLittleEndian<uint32_t>(infoHeaderData, 40);
+                    infoHeader.GreenMask = ReadLittleEndian<uint32_t>(infoHeaderData, 44);
+                    infoHeader.BlueMask = ReadLittleEndian<uint32_t>(infoHeaderData, 48);
+                    infoHeader.AlphaMask = ReadLittleEndian<uint32_t>(infoHeaderData, 52);
 
                     if (infoHeader.RedMask != 0x00FF0000 || infoHeader.GreenMask != 0x0000FF00 || infoHeader.BlueMask != 0x000000FF || infoHeader.AlphaMask != 0xFF000000)
                     {
@@ -108,30 +121,40 @@ namespace yap
             rowSize /= 32;
             rowSize *= 4;
 
-            Bitmap bitmap(infoHeader.Width, infoHeader.Height);
+            Bitmap bitmap(infoHeader.Width, infoHeader.Height, PixelFormat::RGBA8);
 
             file.seekg(header.Offset, std::ios::beg);
 
             std::vector<uint8_t> row(rowSize);
+            std::vector<ColorRGBA8> pixels(infoHeader.Width);
 
             for (int y = 0; y < infoHeader.Height; ++y)
             {
                 file.read(reinterpret_cast<char*>(row.data()), rowSize);
 
-                for (int x = 0; x < infoHeader.Width; ++x)
+                if (!file)
                 {
-                    uint8_t b = row[x * channels];
-                    uint8_t g = row[x * channels + 1];
-                    uint8_t r = row[x * channels + 2];
-                    uint8_t a = 255;
+                    throw std::runtime_error("Unexpected end of BMP file");
+                }
+
+                const uint8_t* source = row.data();
 
-                    if (infoHeader.BitsPerPixel == 32)
+                if (channels == 4)
+                {
+                    for (int x = 0; x < infoHeader.Width; ++x, source += 4)
                     {
-                        a = row[x * channels + 3];
+                        pixels[x] = ColorRGBA8(source[2], source[1], source[0], source[3]);
+                    }
+                }
+                else
+                {
+                    for (int x = 0; x < infoHeader.Width; ++x, source += 3)
+                    {
+                        pixels[x] = ColorRGBA8(source[2], source[1], source[0], 255);
                     }
-
-                    bitmap.SetPixel(x, infoHeader.Height - y - 1, ColorRGBA(r, g, b, a));
                 }
+
+                bitmap.WriteSpan(0, infoHeader.Height - y - 1, infoHeader.Width, pixels.data());
             }
 
             return bitmap;
@@ -178,69 +201,98 @@ namespace yap
                 throw std::runtime_error("Unable to open file for writing: " + path);
             }
 
-            file.write(reinterpret_cast<const char*>(&header.Type), sizeof(header.Type));
-            file.write(reinterpret_cast<const char*>(&header.Size), sizeof(header.Size));
-            file.write(reinterpret_cast<const char*>(&header.Reserved1), sizeof(header.Reserved1));
-            file.write(reinterpret_cast<const char*>(&header.Reserved2), sizeof(header.Reserved2));
-            file.write(reinterpret_cast<const char*>(&header.Offset), sizeof(header.Offset));
-
-            file.write(reinterpret_cast<const char*>(&infoHeader.Size), sizeof(infoHeader.Size));
-            file.write(reinterpret_cast<const char*>(&infoHeader.Width), sizeof(infoHeader.Width));
-            file.write(reinterpret_cast<const char*>(&infoHeader.Height), sizeof(infoHeader.Height));
-            file.write(reinterpret_cast<const char*>(&infoHeader.Planes), sizeof(infoHeader.Planes));
-            file.write(reinterpret_cast<const char*>(&infoHeader.BitsPerPixel), sizeof(infoHeader.BitsPerPixel));
-            file.write(reinterpret_cast<const char*>(&infoHeader.Compression), sizeof(infoHeader.Compression));
-            file.write(reinterpret_cast<const char*>(&infoHeader.ImageSize), sizeof(infoHeader.ImageSize));
-            file.write(reinterpret_cast<const char*>(&infoHeader.XPixelsPerMeter), sizeof(infoHeader.XPixelsPerMeter));
-            file.write(reinterpret_cast<const char*>(&infoHeader.YPixelsPerMeter), sizeof(infoHeader.YPixelsPerMeter));
-            file.write(reinterpret_cast<const char*>(&infoHeader.ColorUsed), sizeof(infoHeader.ColorUsed));
-            file.write(reinterpret_cast<const char*>(&infoHeader.ColorImportant), sizeof(infoHeader.ColorImportant));
-            
+            uint8_t headerData[HeaderSize + MaxInfoHeaderSize] = {};
+            uint8_t* infoHeaderData = headerData + HeaderSize;
+
+            WriteLittleEndian<uint16_t>(headerData, 0, header.Type);
+            WriteLittleEndian<uint32_t>(headerData, 2, header.Size);
+            WriteLittleEndian<uint16_t>(headerData, 6, header.Reserved1);
+            WriteLittleEndian<uint16_t>(headerData, 8, header.Reserved2);
+            WriteLittleEndian<uint32_t>(headerData, 10, header.Offset);
+
+            WriteLittleEndian<uint32_t>(infoHeaderData, 0, infoHeader.Size);
+            WriteLittleEndian<int32_t>(infoHeaderData, 4, infoHeader.Width);
+            WriteLittleEndian<int32_t>(infoHeaderData, 8, infoHeader.Height);
+            WriteLittleEndian<uint16_t>(infoHeaderData, 12, infoHeader.Planes);
+            WriteLittleEndian<uint16_t>(infoHeaderData, 14, infoHeader.BitsPerPixel);
+            WriteLittleEndian<uint32_t>(infoHeaderData, 16, infoHeader.Compression);
+            WriteLittleEndian<uint32_t>(infoHeaderData, 20, infoHeader.ImageSize);
+            WriteLittleEndian<int32_t>(infoHeaderData, 24, infoHeader.XPixelsPerMeter);
+            WriteLittleEndian<int32_t>(infoHeaderData, 28, infoHeader.YPixelsPerMeter);
+            WriteLittleEndian<uint32_t>(infoHeaderData, 32, infoHeader.ColorUsed);
+            WriteLittleEndian<uint32_t>(infoHeaderData, 36, infoHeader.ColorImportant);
+
             if (withAlpha) {
-                file.write(reinterpret_cast<const char*>(&infoHeader.RedMask), sizeof(infoHeader.RedMask));
-                file.write(reinterpret_cast<const char*>(&infoHeader.GreenMask), sizeof(infoHeader.GreenMask));
-                file.write(reinterpret_cast<const char*>(&infoHeader.BlueMask), sizeof(infoHeader.BlueMask));
-                file.write(reinterpret_cast<const char*>(&infoHeader.AlphaMask), sizeof(infoHeader.AlphaMask));
+                WriteLittleEndian<uint32_t>(infoHeaderData, 40, infoHeader.RedMask);
+                WriteLittleEndian<uint32_t>(infoHeaderData, 44, infoHeader.GreenMask);
+                WriteLittleEndian<uint32_t>(infoHeaderData, 48, infoHeader.BlueMask);
+                WriteLittleEndian<uint32_t>(infoHeaderData, 52, infoHeader.AlphaMask);
             }
 
+            file.write(reinterpret_cast<const char*>(headerData), header.Offset);
+
+            std::vector<ColorRGBA8> pixels(bitmap.GetWidth());
+            std::vector<uint8_t> row(rowSize, 0);
+
             for (int y = bitmap.GetHeight() - 1; y >= 0; y--)
             {
-                for (int x = 0; x < bitmap.GetWidth(); x++)
-                {
-                    ColorRGBA color = bitmap.GetPixel(x, y);
-                    uint8_t b = static_cast<uint8_t>(color.B * 255);
-                    uint8_t g = static_cast<uint8_t>(color.G * 255);
-                    uint8_t r = static_cast<uint8_t>(color.R * 255);
-
-                    if (!withAlpha) {
-                        // Premultiply alpha if saving without alpha channel
-                        b = static_cast<uint8_t>(color.B * 255 * color.A);
-                        g = static_cast<uint8_t>(color.G * 255 * color.A);
-                        r = static_cast<uint8_t>(color.R * 255 * color.A);
+                bitmap.ReadSpan(0, y, bitmap.GetWidth(), pixels.data());
+
+                uint8_t* destination = row.data();
+
+                if (withAlpha) {
+                    for (int x = 0; x < bitmap.GetWidth(); x++, destination += 4)
+                    {
+                        destination[0] = pixels[x].B;
+                        destination[1] = pixels[x].G;
+                        destination[2] = pixels[x].R;
+                        destination[3] = pixels[x].A;
                     }
+                } else {
+                    // Premultiply alpha if saving without alpha channel
+                    for (int x = 0; x < bitmap.GetWidth(); x++, destination += 3)
+                    {
+                        uint32_t a = pixels[x].A;
 
-                    file.write(reinterpret_cast<const char*>(&b), sizeof(b));
-                    file.write(reinterpret_cast<const char*>(&g), sizeof(g));
-                    file.write(reinterpret_cast<const char*>(&r), sizeof(r));
-                    
-                    if (withAlpha) {
-                        uint8_t a = static_cast<uint8_t>(color.A * 255);
-                        file.write(reinterpret_cast<const char*>(&a), sizeof(a));
+                        destination[0] = static_cast<uint8_t>((pixels[x].B * a + 127) / 255);
+                        destination[1] = static_cast<uint8_t>((pixels[x].G * a + 127) / 255);
+                        destination[2] = static_cast<uint8_t>((pixels[x].R * a + 127) / 255);
                     }
                 }
 
-                uint32_t padding = 0;
-                int paddingSize = rowSize - bitmap.GetWidth() * bytesPerPixel;\
-                
-                if (paddingSize > 0) {
-                    file.write(reinterpret_cast<const char*>(&padding), paddingSize);
-                }
+                file.write(reinterpret_cast<const char*>(row.data()), rowSize);
             }
 
             file.close();
         }
 
     private:
+        static const int HeaderSize = 14;
+        static const int InfoHeaderSize = 40;
+        static const int MaxInfoHeaderSize = 56;
+
+        template <typename T>
+        static T ReadLittleEndian(const uint8_t* data, size_t offset)
+        {
+            uint64_t value = 0;
+
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                value |= static_cast<uint64_t>(data[offset + i]) << (8 * i);
+            }
+
+            return static_cast<T>(value);
+        }
+
+        template <typename T>
+        static void WriteLittleEndian(uint8_t* data, size_t offset, T value)
+        {
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                data[offset + i] = static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i));
+            }
+        }
+
         struct Header
         {
             uint16_t Type;
@@ -1,15 +1,19 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
 
 /**
  * @file Benchmark.h
  * @brief Provides a utility class for benchmarking code execution time.
- * 
- * This file defines the `yap::Benchmark` class, which allows measuring the 
- * execution time of code blocks. It supports starting, stopping, resetting, 
- * and retrieving timing statistics such as total time, average time, and 
- * the number of samples.
+ *
+ * This file defines the `yap::Benchmark` class, which allows measuring the
+ * execution time of code blocks. It supports starting, stopping, resetting,
+ * and retrieving timing statistics such as total time, average time,
+ * percentiles, and the number of samples.
  */
 
 namespace yap
@@ -17,22 +21,51 @@ namespace yap
     /**
      * @class Benchmark
      * @brief A utility class for measuring code execution time.
-     * 
-     * The `Benchmark` class provides methods to start and stop a timer, 
-     * accumulate timing data, and retrieve statistics such as the total 
+     *
+     * The `Benchmark` class provides methods to start and stop a timer,
+     * accumulate timing data, and retrieve statistics such as the total
      * elapsed time, average time per sample, and the number of samples.
+     *
+     * Besides the total, every sample goes into a log-bucketed histogram, which answers percentiles over
+     * all samples since the last reset within `1 / SubBucketCount` of the true value, and into a rolling
+     * window of the latest samples, which answers exact statistics about the recent past. Both take
+     * constant time and memory per sample, so benchmarks can stay enabled in release builds.
      */
     class Benchmark
     {
+    public:
+        static const size_t DefaultWindowSize = 240;
+
     private:
+        // Samples are bucketed in nanoseconds by their power of two, and each power of two is split into
+        // `SubBucketCount` linear sub-buckets. Values below `SubBucketCount` get a bucket each.
+        static const int SubBucketBits = 4;
+        static const int SubBucketCount = 1 << SubBucketBits;
+        static const int BucketCount = (64 - SubBucketBits + 1) * SubBucketCount;
+
         bool m_Active = false;
 
         std::chrono::high_resolution_clock::time_point m_StartTimepoint;
 
         int32_t m_Samples = 0;
         double m_TotalTime = 0;
-    
+
+        double m_MinTime = 0;
+        double m_MaxTime = 0;
+        double m_LastTime = 0;
+
+        std::vector<uint32_t> m_Histogram;
+
+        std::vector<double> m_Window;
+        size_t m_WindowNext = 0;
+        size_t m_WindowSamples = 0;
+
     public:
+        explicit Benchmark(size_t windowSize = DefaultWindowSize)
+            : m_Histogram(BucketCount), m_Window(std::max<size_t>(windowSize, 1))
+        {
+        }
+
         void Start()
         {
             m_Active = true;
@@ -51,15 +84,42 @@ namespace yap
 
             auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(endTimepoint - m_StartTimepoint);
             double seconds = duration.count() / 1e9;
-            
+
+            AddSample(seconds);
+        }
+
+        /**
+         * @brief Records a duration, in seconds, measured elsewhere.
+         */
+        void AddSample(double seconds)
+        {
+            m_MinTime = m_Samples > 0 ? std::min(m_MinTime, seconds) : seconds;
+            m_MaxTime = m_Samples > 0 ? std::max(m_MaxTime, seconds) : seconds;
+            m_LastTime = seconds;
+
             m_Samples++;
             m_TotalTime += seconds;
+
+            m_Histogram[GetBucket(static_cast<uint64_t>(std::max(0.0, seconds) * 1e9))]++;
+
+            m_Window[m_WindowNext] = seconds;
+            m_WindowNext = (m_WindowNext + 1) % m_Window.size();
+            m_WindowSamples = std::min(m_WindowSamples + 1, m_Window.size());
         }
 
         void Reset()
         {
             m_TotalTime = 0;
             m_Samples = 0;
+
+            m_MinTime = 0;
+            m_MaxTime = 0;
+            m_LastTime = 0;
+
+            std::fill(m_Histogram.begin(), m_Histogram.end(), 0);
+
+            m_WindowNext = 0;
+            m_WindowSamples = 0;
         }
 
         int32_t GetSamples() const
@@ -76,5 +136,119 @@ namespace yap
         {
             return m_TotalTime;
         }
+
+        double GetMinTime() const
+        {
+            return m_MinTime;
+        }
+
+        double GetMaxTime() const
+        {
+            return m_MaxTime;
+        }
+
+        double GetLastTime() const
+        {
+            return m_LastTime;
+        }
+
+        /**
+         * @brief Returns the time below which `percentile` percent of the samples since the last reset fall,
+         * estimated from the histogram.
+         */
+        double GetPercentile(double percentile) const
+        {
+            if (m_Samples == 0)
+            {
+                return 0.0;
+            }
+
+            uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_Samples)));
+            uint64_t count = 0;
+
+            for (int bucket = 0; bucket < BucketCount; ++bucket)
+            {
+                count += m_Histogram[bucket];
+
+                if (count >= target)
+                {
+                    return std::min(std::max(GetBucketMidpoint(bucket) / 1e9, m_MinTime), m_MaxTime);
+                }
+            }
+
+            return m_MaxTime;
+        }
+
+        size_t GetWindowSamples() const
+        {
+            return m_WindowSamples;
+        }
+
+        double GetWindowAverageTime() const
+        {
+            double total = 0.0;
+
+            for (size_t i = 0; i < m_WindowSamples; ++i)
+            {
+                total += m_Window[i];
+            }
+
+            return m_WindowSamples > 0 ? total / m_WindowSamples : 0.0;
+        }
+
+        double GetWindowMaxTime() const
+        {
+            return m_WindowSamples > 0 ? *std::max_element(m_Window.begin(), m_Window.begin() + m_WindowSamples) : 0.0;
+        }
+
+        /**
+         * @brief Returns the exact `percentile` of the samples in the rolling window.
+         */
+        double GetWindowPercentile(double percentile) const
+        {
+            if (m_WindowSamples == 0)
+            {
+                return 0.0;
+            }
+
+            std::vector<double> samples(m_Window.begin(), m_Window.begin() + m_WindowSamples);
+
+            size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * samples.size()));
+            size_t index = std::min(samples.size(), std::max<size_t>(rank, 1)) - 1;
+
+            std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+
+            return samples[index];
+        }
+
+    private:
+        static int GetBucket(uint64_t nanoseconds)
+        {
+            if (nanoseconds < static_cast<uint64_t>(SubBucketCount))
+            {
+                return static_cast<int>(nanoseconds);
+            }
+
+            int exponent = 63 - __builtin_clzll(nanoseconds);
+            int subBucket = static_cast<int>((nanoseconds >> (exponent - SubBucketBits)) & (SubBucketCount - 1));
+
+            return (exponent - SubBucketBits + 1) * SubBucketCount + subBucket;
+        }
+
+        static double GetBucketMidpoint(int bucket)
+        {
+            if (bucket < SubBucketCount)
+            {
+                return bucket;
+            }
+
+            int exponent = bucket / SubBucketCount + SubBucketBits - 1;
+            int subBucket = bucket % SubBucketCount;
+
+            double lower = std::ldexp(static_cast<double>(SubBucketCount + subBucket), exponent - SubBucketBits);
+            double width = std::ldexp(1.0, exponent - SubBucketBits);
+
+            return lower + width / 2.0;
+        }
     };
-}
\ No newline at end of file
+}
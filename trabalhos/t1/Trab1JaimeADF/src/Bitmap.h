@@ -1,9 +1,16 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <climits>
+#include <cstdint>
+#include <memory>
 
 #include "Math.h"
 #include "Color.h"
+#include "Rect.h"
 #include "Vec2.h"
 
 /**
@@ -23,74 +30,347 @@ namespace yap
         Bilinear
     };
 
+    /**
+     * @enum PixelFormat
+     * @brief Specifies how the pixels of a bitmap are stored in memory.
+     */
+    enum class PixelFormat
+    {
+        RGBA8,   ///< 8-bit unsigned integer per channel (4 bytes per pixel).
+        RGBAF32  ///< 32-bit float per channel (16 bytes per pixel).
+    };
+
     /**
      * @class Bitmap
      * @brief Represents a 2D image with pixel manipulation capabilities.
+     *
+     * Pixels are stored in the format chosen at construction. `GetPixel` and `SetPixel` always speak
+     * `ColorRGBA` and convert on the fly, so algorithms work regardless of the format; hot loops should
+     * prefer the span accessors, which copy whole runs of pixels at once.
+     *
+     * The image is split into square tiles of `TileSize` pixels. Tiles whose pixels are all zero (fully
+     * transparent black) are not stored, so empty and mostly empty bitmaps cost little memory, and code
+     * that walks over a bitmap can skip them through `IsTileEmpty`, `IsRegionEmpty` or `ForEachTile`.
+     * Tiles are shared between copies of a bitmap and copied on the first write, which makes copying a
+     * bitmap proportional to its number of tiles rather than pixels.
+     *
+     * Reading is safe from any number of threads. Writes may run concurrently as long as each thread
+     * writes to its own tiles; rows of tiles (bands of `TileSize` rows) are a convenient unit for that.
+     *
+     * Writes give the bitmap a new revision, drawn from a counter shared by all bitmaps when it is next
+     * asked for, so a bulk write only costs one. Copies keep the revision of their source, so two bitmaps
+     * with the same revision hold the same pixels, and caches derived from a bitmap only need to remember
+     * the revision they were built from. The bitmap
+     * also accumulates the rectangle covered by the writes since its owner last called `ResetDirtyRect`,
+     * which lets such a cache refresh only what changed through `GetDirtyRect`.
      */
     class Bitmap
     {
+    public:
+        static const int TileSize = 64;
+
     private:
+        template <typename Pixel>
+        struct Tile
+        {
+            Pixel Pixels[TileSize * TileSize];
+        };
+
+        template <typename Pixel>
+        using TileList = std::vector<std::shared_ptr<Tile<Pixel>>>;
+
+        // Writes only mark the revision stale, by setting it to 0, and the next `GetRevision` draws a new one
+        // from the counter shared by all bitmaps. A bulk write then costs a load per pixel once the mark is
+        // set, rather than a bump of the shared counter. Readers that race to draw one agree on the first.
+        struct Revision
+        {
+            mutable std::atomic<uint64_t> Value;
+
+            Revision() : Value(0)
+            {
+            }
+
+            Revision(const Revision& other) : Value(other.Get())
+            {
+            }
+
+            Revision& operator=(const Revision& other)
+            {
+                Value.store(other.Get(), std::memory_order_relaxed);
+                return *this;
+            }
+
+            void Invalidate()
+            {
+                if (Value.load(std::memory_order_relaxed) != 0)
+                {
+                    Value.store(0, std::memory_order_relaxed);
+                }
+            }
+
+            uint64_t Get() const
+            {
+                static std::atomic<uint64_t> s_LastRevision(0);
+
+                uint64_t value = Value.load(std::memory_order_relaxed);
+
+                if (value != 0)
+                {
+                    return value;
+                }
+
+                uint64_t drawn = s_LastRevision.fetch_add(1, std::memory_order_relaxed) + 1;
+
+                return Value.compare_exchange_strong(value, drawn, std::memory_order_relaxed) ? drawn : value;
+            }
+        };
+
+        // Bounds of the pixels written since the last reset, grown lock-free by concurrent writers.
+        struct DirtyBounds
+        {
+            std::atomic<int> Left;
+            std::atomic<int> Top;
+            std::atomic<int> Right;
+            std::atomic<int> Bottom;
+
+            DirtyBounds()
+            {
+                Reset();
+            }
+
+            // Copying a bitmap replaces all of its pixels, so the copy starts out entirely dirty.
+            DirtyBounds(const DirtyBounds&) : Left(INT_MIN), Top(INT_MIN), Right(INT_MAX), Bottom(INT_MAX)
+            {
+            }
+
+            DirtyBounds& operator=(const DirtyBounds&)
+            {
+                Left.store(INT_MIN, std::memory_order_relaxed);
+                Top.store(INT_MIN, std::memory_order_relaxed);
+                Right.store(INT_MAX, std::memory_order_relaxed);
+                Bottom.store(INT_MAX, std::memory_order_relaxed);
+
+                return *this;
+            }
+
+            void Reset()
+            {
+                Left.store(INT_MAX, std::memory_order_relaxed);
+                Top.store(INT_MAX, std::memory_order_relaxed);
+                Right.store(INT_MIN, std::memory_order_relaxed);
+                Bottom.store(INT_MIN, std::memory_order_relaxed);
+            }
+
+            void Extend(int left, int top, int right, int bottom)
+            {
+                Lower(Left, left);
+                Lower(Top, top);
+                Raise(Right, right);
+                Raise(Bottom, bottom);
+            }
+
+            static void Lower(std::atomic<int>& bound, int value)
+            {
+                int current = bound.load(std::memory_order_relaxed);
+                while (value < current && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed));
+            }
+
+            static void Raise(std::atomic<int>& bound, int value)
+            {
+                int current = bound.load(std::memory_order_relaxed);
+                while (value > current && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed));
+            }
+        };
+
         int m_Width;
         int m_Height;
 
-        std::vector<ColorRGBA> m_Pixels;
-    
+        PixelFormat m_Format;
+
+        int m_Columns = 0;
+        int m_Rows = 0;
+
+        TileList<ColorRGBA8> m_Tiles8;
+        TileList<ColorRGBA> m_TilesF32;
+
+        Revision m_Revision;
+
+        DirtyBounds m_DirtyBounds;
+        uint64_t m_DirtySince = 0;
+
     public:
         Bitmap() : Bitmap(0, 0)
         {
         }
 
-        Bitmap(int width, int height) : m_Width(width), m_Height(height), m_Pixels(width * height, ColorRGBA(0, 0, 0, 0))
+        Bitmap(int width, int height, PixelFormat format = PixelFormat::RGBA8)
+            : m_Width(-1), m_Height(-1), m_Format(format)
         {
+            Reallocate(width, height, format);
         }
 
         void FlipHorizontally()
         {
-            for (int y = 0; y < m_Height; ++y)
+            if (m_Format == PixelFormat::RGBA8)
             {
-                for (int x = 0; x < m_Width / 2; ++x)
-                {
-                    std::swap(m_Pixels[y * m_Width + x], m_Pixels[y * m_Width + (m_Width - 1 - x)]);
-                }
+                FlipHorizontally<ColorRGBA8>();
+            }
+            else
+            {
+                FlipHorizontally<ColorRGBA>();
             }
         }
 
         void FlipVertically()
         {
-            for (int y = 0; y < m_Height / 2; ++y)
+            if (m_Format == PixelFormat::RGBA8)
             {
-                for (int x = 0; x < m_Width; ++x)
-                {
-                    std::swap(m_Pixels[y * m_Width + x], m_Pixels[(m_Height - 1 - y) * m_Width + x]);
-                }
+                FlipVertically<ColorRGBA8>();
+            }
+            else
+            {
+                FlipVertically<ColorRGBA>();
             }
         }
 
+        /**
+         * @brief Fills the bitmap with `color`. Clearing to transparent releases every tile, and any other
+         * color is stored in a single tile shared by the whole bitmap until it is written to.
+         */
         void Clear(const ColorRGBA& color = ColorRGBA(0, 0, 0, 0))
         {
-            std::fill(m_Pixels.begin(), m_Pixels.end(), color);
+            if (m_Format == PixelFormat::RGBA8)
+            {
+                Clear(m_Tiles8, ColorRGBA8(color));
+            }
+            else
+            {
+                Clear(m_TilesF32, ColorRGBA::Clamp(color));
+            }
         }
 
         void Reallocate(int width, int height)
         {
-            if (width == m_Width && height == m_Height)
+            Reallocate(width, height, m_Format);
+        }
+
+        /**
+         * @brief Resizes the bitmap, leaving it fully transparent. Nothing happens, and the pixels are kept,
+         * when the size and format are already the requested ones.
+         */
+        void Reallocate(int width, int height, PixelFormat format)
+        {
+            if (width == m_Width && height == m_Height && format == m_Format)
             {
                 return;
             }
 
             m_Width = width;
             m_Height = height;
-            m_Pixels.resize(width * height);
+            m_Format = format;
+
+            Touch();
+            ResetDirtyRect();
+
+            m_Columns = (width + TileSize - 1) / TileSize;
+            m_Rows = (height + TileSize - 1) / TileSize;
+
+            size_t count = static_cast<size_t>(m_Columns) * m_Rows;
+
+            m_Tiles8.clear();
+            m_TilesF32.clear();
+
+            if (format == PixelFormat::RGBA8)
+            {
+                m_Tiles8.resize(count);
+                m_Tiles8.shrink_to_fit();
+            }
+            else
+            {
+                m_TilesF32.resize(count);
+                m_TilesF32.shrink_to_fit();
+            }
         }
 
         void SetPixel(int x, int y, const ColorRGBA& color)
         {
-            m_Pixels[y * m_Width + x] = ColorRGBA::Clamp(color);
+            if (m_Format == PixelFormat::RGBA8)
+            {
+                WriteSpan(m_Tiles8, x, y, 1, &color);
+            }
+            else
+            {
+                WriteSpan(m_TilesF32, x, y, 1, &color);
+            }
+        }
+
+        ColorRGBA GetPixel(int x, int y) const
+        {
+            size_t index = GetTileIndex(x / TileSize, y / TileSize);
+            size_t offset = (y % TileSize) * TileSize + (x % TileSize);
+
+            if (m_Format == PixelFormat::RGBA8)
+            {
+                const Tile<ColorRGBA8>* tile = m_Tiles8[index].get();
+                return tile ? tile->Pixels[offset].ToRGBA() : ColorRGBA(0.0f, 0.0f, 0.0f, 0.0f);
+            }
+
+            const Tile<ColorRGBA>* tile = m_TilesF32[index].get();
+            return tile ? tile->Pixels[offset] : ColorRGBA(0.0f, 0.0f, 0.0f, 0.0f);
+        }
+
+        /**
+         * @brief Copies `count` pixels starting at (x, y) into `pixels`, converting them if needed.
+         */
+        void ReadSpan(int x, int y, int count, ColorRGBA8* pixels) const
+        {
+            if (m_Format == PixelFormat::RGBA8)
+            {
+                ReadSpan(m_Tiles8, x, y, count, pixels);
+            }
+            else
+            {
+                ReadSpan(m_TilesF32, x, y, count, pixels);
+            }
+        }
+
+        void ReadSpan(int x, int y, int count, ColorRGBA* pixels) const
+        {
+            if (m_Format == PixelFormat::RGBA8)
+            {
+                ReadSpan(m_Tiles8, x, y, count, pixels);
+            }
+            else
+            {
+                ReadSpan(m_TilesF32, x, y, count, pixels);
+            }
         }
 
-        const ColorRGBA &GetPixel(int x, int y) const
+        /**
+         * @brief Copies `count` pixels from `pixels` into the bitmap starting at (x, y), converting them if needed.
+         */
+        void WriteSpan(int x, int y, int count, const ColorRGBA8* pixels)
         {
-            return m_Pixels[y * m_Width + x];
+            if (m_Format == PixelFormat::RGBA8)
+            {
+                WriteSpan(m_Tiles8, x, y, count, pixels);
+            }
+            else
+            {
+                WriteSpan(m_TilesF32, x, y, count, pixels);
+            }
+        }
+
+        void WriteSpan(int x, int y, int count, const ColorRGBA* pixels)
+        {
+            if (m_Format == PixelFormat::RGBA8)
+            {
+                WriteSpan(m_Tiles8, x, y, count, pixels);
+            }
+            else
+            {
+                WriteSpan(m_TilesF32, x, y, count, pixels);
+            }
         }
 
         int GetWidth() const
@@ -103,28 +383,210 @@ namespace yap
             return m_Height;
         }
 
+        PixelFormat GetFormat() const
+        {
+            return m_Format;
+        }
+
+        int GetTileColumnCount() const
+        {
+            return m_Columns;
+        }
+
+        int GetTileRowCount() const
+        {
+            return m_Rows;
+        }
+
+        /**
+         * @brief Returns the pixels covered by a tile, which are fewer than `TileSize` squared at the right
+         * and bottom edges.
+         */
+        Rect GetTileBounds(int column, int row) const
+        {
+            int x = column * TileSize;
+            int y = row * TileSize;
+
+            return Rect(x, y, std::min(m_Width - x, static_cast<int>(TileSize)), std::min(m_Height - y, static_cast<int>(TileSize)));
+        }
+
+        bool IsTileEmpty(int column, int row) const
+        {
+            size_t index = GetTileIndex(column, row);
+            return m_Format == PixelFormat::RGBA8 ? !m_Tiles8[index] : !m_TilesF32[index];
+        }
+
+        /**
+         * @brief Whether every pixel of `region` (clipped to the bitmap) lies in an empty tile.
+         */
+        bool IsRegionEmpty(const Rect& region) const
+        {
+            Rect clipped = Rect::Intersect(region, Rect(0, 0, m_Width, m_Height));
+
+            if (clipped.IsEmpty())
+            {
+                return true;
+            }
+
+            for (int row = clipped.GetTop() / TileSize; row <= (clipped.GetBottom() - 1) / TileSize; ++row)
+            {
+                for (int column = clipped.GetLeft() / TileSize; column <= (clipped.GetRight() - 1) / TileSize; ++column)
+                {
+                    if (!IsTileEmpty(column, row))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Calls `function(bounds)` with the bounds of every tile that is stored.
+         */
+        template <typename Function>
+        void ForEachTile(Function function) const
+        {
+            for (int row = 0; row < m_Rows; ++row)
+            {
+                for (int column = 0; column < m_Columns; ++column)
+                {
+                    if (!IsTileEmpty(column, row))
+                    {
+                        function(GetTileBounds(column, row));
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Whether this bitmap and `other`, which must have the same size and format, hold the very
+         * same tile at (column, row). Two empty tiles count as shared.
+         */
+        bool SharesTile(const Bitmap& other, int column, int row) const
+        {
+            size_t index = GetTileIndex(column, row);
+            return m_Format == PixelFormat::RGBA8 ? m_Tiles8[index] == other.m_Tiles8[index] : m_TilesF32[index] == other.m_TilesF32[index];
+        }
+
+        /**
+         * @brief Returns the memory taken by the pixels of a single stored tile.
+         */
+        size_t GetTileByteSize() const
+        {
+            return m_Format == PixelFormat::RGBA8 ? sizeof(Tile<ColorRGBA8>) : sizeof(Tile<ColorRGBA>);
+        }
+
+        /**
+         * @brief Returns the revision of the pixels, which changes on every write and is never 0.
+         */
+        uint64_t GetRevision() const
+        {
+            return m_Revision.Get();
+        }
+
+        /**
+         * @brief Returns a rectangle that covers every pixel written since the bitmap had `revision`. That
+         * is the whole bitmap when `revision` predates the last call to `ResetDirtyRect`, or the last
+         * reallocation, since the writes before it are no longer tracked.
+         */
+        Rect GetDirtyRect(uint64_t revision) const
+        {
+            if (revision == GetRevision())
+            {
+                return Rect();
+            }
+
+            Rect bounds(0, 0, m_Width, m_Height);
+
+            if (revision < m_DirtySince)
+            {
+                return bounds;
+            }
+
+            int left = std::max(m_DirtyBounds.Left.load(std::memory_order_relaxed), 0);
+            int top = std::max(m_DirtyBounds.Top.load(std::memory_order_relaxed), 0);
+            int right = std::min(m_DirtyBounds.Right.load(std::memory_order_relaxed), m_Width);
+            int bottom = std::min(m_DirtyBounds.Bottom.load(std::memory_order_relaxed), m_Height);
+
+            return right > left && bottom > top ? Rect(left, top, right - left, bottom - top) : Rect();
+        }
+
+        /**
+         * @brief Starts accumulating the dirty rectangle anew from the current revision. Must not run
+         * concurrently with writes.
+         */
+        void ResetDirtyRect()
+        {
+            m_DirtyBounds.Reset();
+            m_DirtySince = GetRevision();
+        }
+
         static void Rotate(const Bitmap& source, Bitmap& destination, float radians, Vec2 pivot, Vec2 offset)
         {
             destination.Clear();
-            
-            for (int y = 0; y < destination.GetHeight(); ++y)
+
+            for (int row = 0; row < destination.m_Rows; ++row)
             {
-                for (int x = 0; x < destination.GetWidth(); ++x)
+                for (int column = 0; column < destination.m_Columns; ++column)
                 {
-                    Vec2 sourcePosition = Vec2(x, y) - offset;
-                    sourcePosition.Rotate(-radians, pivot);
+                    Rect tile = destination.GetTileBounds(column, row);
 
-                    int sourceX = static_cast<int>(sourcePosition.X);
-                    int sourceY = static_cast<int>(sourcePosition.Y);
+                    // The source pixels that can land in this tile lie within the box around its rotated corners.
+                    Vec2 corners[4] = {
+                        Vec2(tile.GetLeft(), tile.GetTop()),
+                        Vec2(tile.GetRight(), tile.GetTop()),
+                        Vec2(tile.GetLeft(), tile.GetBottom()),
+                        Vec2(tile.GetRight(), tile.GetBottom())
+                    };
 
-                    if (sourceX >= 0 && sourceX < source.GetWidth() && sourceY >= 0 && sourceY < source.GetHeight())
+                    float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+
+                    for (int i = 0; i < 4; ++i)
                     {
-                        destination.SetPixel(x, y, source.GetPixel(sourceX, sourceY));
+                        Vec2 corner = corners[i] - offset;
+                        corner.Rotate(-radians, pivot);
+
+                        minX = i == 0 ? corner.X : std::min(minX, corner.X);
+                        minY = i == 0 ? corner.Y : std::min(minY, corner.Y);
+                        maxX = i == 0 ? corner.X : std::max(maxX, corner.X);
+                        maxY = i == 0 ? corner.Y : std::max(maxY, corner.Y);
+                    }
+
+                    int left = static_cast<int>(std::floor(minX)) - 1;
+                    int top = static_cast<int>(std::floor(minY)) - 1;
+
+                    Rect reach(left, top, static_cast<int>(std::ceil(maxX)) + 2 - left, static_cast<int>(std::ceil(maxY)) + 2 - top);
+
+                    if (source.IsRegionEmpty(reach))
+                    {
+                        continue;
+                    }
+
+                    for (int y = tile.GetTop(); y < tile.GetBottom(); ++y)
+                    {
+                        for (int x = tile.GetLeft(); x < tile.GetRight(); ++x)
+                        {
+                            Vec2 sourcePosition = Vec2(x, y) - offset;
+                            sourcePosition.Rotate(-radians, pivot);
+
+                            int sourceX = static_cast<int>(sourcePosition.X);
+                            int sourceY = static_cast<int>(sourcePosition.Y);
+
+                            if (sourceX >= 0 && sourceX < source.GetWidth() && sourceY >= 0 && sourceY < source.GetHeight())
+                            {
+                                destination.StorePixel(x, y, source.GetPixel(sourceX, sourceY));
+                            }
+                        }
                     }
                 }
             }
+
+            // The pixels were stored unmarked, so the destination is marked as a whole once they are all in.
+            destination.Touch(Rect(0, 0, destination.m_Width, destination.m_Height));
         }
-        
+
         static void Scale(const Bitmap& source, Bitmap& destination, ScalingMethod method = ScalingMethod::NearestNeighbor)
         {
             switch (method)
@@ -137,63 +599,351 @@ namespace yap
                     break;
             }
         }
-    
+
     private:
+        void StorePixel(int x, int y, const ColorRGBA& color)
+        {
+            if (m_Format == PixelFormat::RGBA8)
+            {
+                StoreSpan(m_Tiles8, x, y, 1, &color);
+            }
+            else
+            {
+                StoreSpan(m_TilesF32, x, y, 1, &color);
+            }
+        }
+
+        size_t GetTileIndex(int column, int row) const
+        {
+            return static_cast<size_t>(row) * m_Columns + column;
+        }
+
+        /**
+         * @brief Returns the region of `source` that the destination pixels of `tile` sample when scaling,
+         * with a pixel of margin for bilinear filtering.
+         */
+        static Rect GetScaledSourceRegion(const Bitmap& source, const Bitmap& destination, const Rect& tile)
+        {
+            float xRatio = static_cast<float>(source.GetWidth()) / destination.GetWidth();
+            float yRatio = static_cast<float>(source.GetHeight()) / destination.GetHeight();
+
+            int left = static_cast<int>(tile.GetLeft() * xRatio);
+            int top = static_cast<int>(tile.GetTop() * yRatio);
+            int right = static_cast<int>(std::ceil(tile.GetRight() * xRatio)) + 1;
+            int bottom = static_cast<int>(std::ceil(tile.GetBottom() * yRatio)) + 1;
+
+            return Rect(left, top, right - left, bottom - top);
+        }
+
         static void ScaleNearestNeighbor(const Bitmap& source, Bitmap& destination)
         {
+            destination.Clear();
+
             if (source.GetWidth() == 0 || source.GetHeight() == 0)
             {
-                destination.Clear();
                 return;
             }
 
             float xRatio = static_cast<float>(source.GetWidth()) / destination.GetWidth();
             float yRatio = static_cast<float>(source.GetHeight()) / destination.GetHeight();
-            
-            for (int y = 0; y < destination.GetHeight(); ++y)
+
+            for (int row = 0; row < destination.m_Rows; ++row)
             {
-                for (int x = 0; x < destination.GetWidth(); ++x)
+                for (int column = 0; column < destination.m_Columns; ++column)
                 {
-                    int sourceX = static_cast<int>(x * xRatio);
-                    int sourceY = static_cast<int>(y * yRatio);
+                    Rect tile = destination.GetTileBounds(column, row);
+
+                    if (source.IsRegionEmpty(GetScaledSourceRegion(source, destination, tile)))
+                    {
+                        continue;
+                    }
 
-                    destination.SetPixel(x, y, source.GetPixel(sourceX, sourceY));
+                    for (int y = tile.GetTop(); y < tile.GetBottom(); ++y)
+                    {
+                        for (int x = tile.GetLeft(); x < tile.GetRight(); ++x)
+                        {
+                            int sourceX = static_cast<int>(x * xRatio);
+                            int sourceY = static_cast<int>(y * yRatio);
+
+                            destination.StorePixel(x, y, source.GetPixel(sourceX, sourceY));
+                        }
+                    }
                 }
             }
+
+            // The pixels were stored unmarked, so the destination is marked as a whole once they are all in.
+            destination.Touch(Rect(0, 0, destination.m_Width, destination.m_Height));
         }
 
         static void ScaleBilinear(const Bitmap& source, Bitmap& destination)
         {
+            destination.Clear();
+
             float xRatio = static_cast<float>(source.GetWidth()) / destination.GetWidth();
             float yRatio = static_cast<float>(source.GetHeight()) / destination.GetHeight();
 
-            for (int y = 0; y < destination.GetHeight(); ++y)
+            for (int row = 0; row < destination.m_Rows; ++row)
+            {
+                for (int column = 0; column < destination.m_Columns; ++column)
+                {
+                    Rect tile = destination.GetTileBounds(column, row);
+
+                    if (source.IsRegionEmpty(GetScaledSourceRegion(source, destination, tile)))
+                    {
+                        continue;
+                    }
+
+                    for (int y = tile.GetTop(); y < tile.GetBottom(); ++y)
+                    {
+                        for (int x = tile.GetLeft(); x < tile.GetRight(); ++x)
+                        {
+                            float srcX = x * xRatio;
+                            float srcY = y * yRatio;
+
+                            int x1 = static_cast<int>(srcX);
+                            int y1 = static_cast<int>(srcY);
+                            int x2 = std::min(x1 + 1, source.GetWidth() - 1);
+                            int y2 = std::min(y1 + 1, source.GetHeight() - 1);
+
+                            float dx = srcX - x1;
+                            float dy = srcY - y1;
+
+                            ColorRGBA c00 = source.GetPixel(x1, y1);
+                            ColorRGBA c10 = source.GetPixel(x2, y1);
+                            ColorRGBA c01 = source.GetPixel(x1, y2);
+                            ColorRGBA c11 = source.GetPixel(x2, y2);
+
+                            ColorRGBA top = ColorRGBA::Lerp(c00, c10, dx);
+                            ColorRGBA bottom = ColorRGBA::Lerp(c01, c11, dx);
+                            ColorRGBA finalColor = ColorRGBA::Lerp(top, bottom, dy);
+
+                            destination.StorePixel(x, y, finalColor);
+                        }
+                    }
+                }
+            }
+
+            // The pixels were stored unmarked, so the destination is marked as a whole once they are all in.
+            destination.Touch(Rect(0, 0, destination.m_Width, destination.m_Height));
+        }
+
+        template <typename Pixel, typename Output>
+        void ReadSpan(const TileList<Pixel>& tiles, int x, int y, int count, Output* pixels) const
+        {
+            size_t rowOffset = static_cast<size_t>(y % TileSize) * TileSize;
+            size_t rowIndex = GetTileIndex(0, y / TileSize);
+
+            while (count > 0)
+            {
+                int tileX = x % TileSize;
+                int length = std::min(count, TileSize - tileX);
+
+                const Tile<Pixel>* tile = tiles[rowIndex + x / TileSize].get();
+
+                if (tile)
+                {
+                    ConvertPixels(tile->Pixels + rowOffset + tileX, pixels, length);
+                }
+                else
+                {
+                    MakeTransparent(pixels, length);
+                }
+
+                x += length;
+                pixels += length;
+                count -= length;
+            }
+        }
+
+        template <typename Pixel, typename Input>
+        void WriteSpan(TileList<Pixel>& tiles, int x, int y, int count, const Input* pixels)
+        {
+            StoreSpan(tiles, x, y, count, pixels);
+
+            // Marked after the pixels are stored, so a reader that draws a revision in between still sees
+            // the mark and draws another one later.
+            Touch(Rect(x, y, count, 1));
+        }
+
+        /**
+         * @brief Writes pixels without marking them, for bulk operations that mark their whole destination
+         * once instead of once per pixel.
+         */
+        template <typename Pixel, typename Input>
+        void StoreSpan(TileList<Pixel>& tiles, int x, int y, int count, const Input* pixels)
+        {
+            size_t rowOffset = static_cast<size_t>(y % TileSize) * TileSize;
+            size_t rowIndex = GetTileIndex(0, y / TileSize);
+
+            while (count > 0)
+            {
+                int tileX = x % TileSize;
+                int length = std::min(count, TileSize - tileX);
+
+                std::shared_ptr<Tile<Pixel>>& tile = tiles[rowIndex + x / TileSize];
+
+                // Writing nothing but transparent pixels to an empty tile leaves it empty.
+                if (tile || !AreTransparent(pixels, length))
+                {
+                    ConvertPixels(pixels, EditTile(tile)->Pixels + rowOffset + tileX, length);
+                }
+
+                x += length;
+                pixels += length;
+                count -= length;
+            }
+        }
+
+        /**
+         * @brief Returns a tile that can be written to, allocating it if empty and copying it if shared.
+         */
+        template <typename Pixel>
+        static Tile<Pixel>* EditTile(std::shared_ptr<Tile<Pixel>>& tile)
+        {
+            if (!tile)
+            {
+                tile = std::make_shared<Tile<Pixel>>();
+                MakeTransparent(tile->Pixels, TileSize * TileSize);
+            }
+            else if (tile.use_count() > 1)
+            {
+                tile = std::make_shared<Tile<Pixel>>(*tile);
+            }
+
+            return tile.get();
+        }
+
+        template <typename Pixel>
+        void Clear(TileList<Pixel>& tiles, const Pixel& color)
+        {
+            std::shared_ptr<Tile<Pixel>> tile;
+
+            if (!AreTransparent(&color, 1))
+            {
+                tile = std::make_shared<Tile<Pixel>>();
+                std::fill(tile->Pixels, tile->Pixels + TileSize * TileSize, color);
+            }
+
+            std::fill(tiles.begin(), tiles.end(), tile);
+
+            Touch(Rect(0, 0, m_Width, m_Height));
+        }
+
+        void Touch()
+        {
+            m_Revision.Invalidate();
+        }
+
+        void Touch(const Rect& region)
+        {
+            Touch();
+            m_DirtyBounds.Extend(region.GetLeft(), region.GetTop(), region.GetRight(), region.GetBottom());
+        }
+
+        template <typename Pixel>
+        void FlipHorizontally()
+        {
+            Bitmap flipped(m_Width, m_Height, m_Format);
+            std::vector<Pixel> row(m_Width);
+
+            for (int y = 0; y < m_Height; ++y)
+            {
+                if (IsRegionEmpty(Rect(0, y, m_Width, 1)))
+                {
+                    continue;
+                }
+
+                ReadSpan(0, y, m_Width, row.data());
+                std::reverse(row.begin(), row.end());
+                flipped.WriteSpan(0, y, m_Width, row.data());
+            }
+
+            *this = std::move(flipped);
+        }
+
+        template <typename Pixel>
+        void FlipVertically()
+        {
+            Bitmap flipped(m_Width, m_Height, m_Format);
+            std::vector<Pixel> row(m_Width);
+
+            for (int y = 0; y < m_Height; ++y)
             {
-                for (int x = 0; x < destination.GetWidth(); ++x)
+                if (IsRegionEmpty(Rect(0, y, m_Width, 1)))
                 {
-                    float srcX = x * xRatio;
-                    float srcY = y * yRatio;
+                    continue;
+                }
+
+                ReadSpan(0, y, m_Width, row.data());
+                flipped.WriteSpan(0, m_Height - 1 - y, m_Width, row.data());
+            }
+
+            *this = std::move(flipped);
+        }
+
+        static void ConvertPixels(const ColorRGBA8* source, ColorRGBA8* destination, int count)
+        {
+            std::copy(source, source + count, destination);
+        }
+
+        static void ConvertPixels(const ColorRGBA8* source, ColorRGBA* destination, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                destination[i] = source[i].ToRGBA();
+            }
+        }
+
+        static void ConvertPixels(const ColorRGBA* source, ColorRGBA8* destination, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                destination[i] = ColorRGBA8(source[i]);
+            }
+        }
 
-                    int x1 = static_cast<int>(srcX);
-                    int y1 = static_cast<int>(srcY);
-                    int x2 = std::min(x1 + 1, source.GetWidth() - 1);
-                    int y2 = std::min(y1 + 1, source.GetHeight() - 1);
+        static void ConvertPixels(const ColorRGBA* source, ColorRGBA* destination, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                destination[i] = ColorRGBA::Clamp(source[i]);
+            }
+        }
 
-                    float dx = srcX - x1;
-                    float dy = srcY - y1;
+        static void MakeTransparent(ColorRGBA8* pixels, int count)
+        {
+            std::fill(pixels, pixels + count, ColorRGBA8(0, 0, 0, 0));
+        }
+
+        static void MakeTransparent(ColorRGBA* pixels, int count)
+        {
+            std::fill(pixels, pixels + count, ColorRGBA(0.0f, 0.0f, 0.0f, 0.0f));
+        }
 
-                    ColorRGBA c00 = source.GetPixel(x1, y1);
-                    ColorRGBA c10 = source.GetPixel(x2, y1);
-                    ColorRGBA c01 = source.GetPixel(x1, y2);
-                    ColorRGBA c11 = source.GetPixel(x2, y2);
+        static bool AreTransparent(const ColorRGBA8* pixels, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                if (pixels[i].R != 0 || pixels[i].G != 0 || pixels[i].B != 0 || pixels[i].A != 0)
+                {
+                    return false;
+                }
+            }
 
-                    ColorRGBA top = ColorRGBA::Lerp(c00, c10, dx);
-                    ColorRGBA bottom = ColorRGBA::Lerp(c01, c11, dx);
-                    ColorRGBA finalColor = ColorRGBA::Lerp(top, bottom, dy);
+            return true;
+        }
 
-                    destination.SetPixel(x, y, finalColor);
+        static bool AreTransparent(const ColorRGBA* pixels, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                if (pixels[i].R > 0.0f || pixels[i].G > 0.0f || pixels[i].B > 0.0f || pixels[i].A > 0.0f)
+                {
+                    return false;
                 }
             }
+
+            return true;
         }
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "Bitmap.h"
+#include "EffectContext.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
+
+/**
+ * @file Blur.h
+ * @brief Defines the GaussianBlur class, a separable and multithreaded Gaussian blur.
+ */
+
+namespace yap
+{
+    /**
+     * @class GaussianBlur
+     * @brief Blurs bitmaps with a separable Gaussian filter whose cost does not depend on the radius.
+     *
+     * Small radii are convolved with a sampled Gaussian kernel. Above `DirectKernelMaxRadius` the filter
+     * is approximated by three successive box blurs computed with running sums, so each pixel costs the
+     * same regardless of the radius. Both passes work on rows: the horizontal pass writes its result
+     * transposed, the vertical pass blurs those rows and transposes back. Rows are spread over the shared
+     * thread pool.
+     *
+     * The working buffers are kept between calls, so reusing an instance avoids reallocating them. Progress is
+     * reported per row of each pass, and a cancelled context stops the blur between chunks of rows.
+     */
+    class GaussianBlur
+    {
+    private:
+        std::vector<ColorRGBA> m_Pixels;
+        std::vector<ColorRGBA> m_Transposed;
+
+        // Two rows per thread that blurs, which the box blur passes ping-pong between.
+        std::vector<ColorRGBA> m_Rows;
+
+    public:
+        static constexpr float DirectKernelMaxRadius = 3.0f;
+
+        GaussianBlur() = default;
+
+        /**
+         * @brief Copies start without working buffers, so cloning an effect for a background job does not
+         * duplicate the scratch space of the original.
+         */
+        GaussianBlur(const GaussianBlur&)
+        {
+        }
+
+        GaussianBlur& operator=(const GaussianBlur&)
+        {
+            return *this;
+        }
+
+        void Apply(const Bitmap& source, Bitmap& destination, float radius, const EffectContext& context = EffectContext())
+        {
+            ProfileScope scope("GaussianBlur::Apply");
+
+            int width = source.GetWidth();
+            int height = source.GetHeight();
+
+            destination.Reallocate(width, height, source.GetFormat());
+
+            if (width == 0 || height == 0)
+            {
+                return;
+            }
+
+            size_t count = static_cast<size_t>(width) * height;
+
+            m_Pixels.resize(count);
+            m_Transposed.resize(count);
+
+            ThreadPool& pool = ThreadPool::GetShared();
+
+            context.BeginRows(height + width);
+
+            pool.ParallelFor(height, [&](int y) {
+                source.ReadSpan(0, y, width, &m_Pixels[static_cast<size_t>(y) * width]);
+            });
+
+            BlurRowsTransposed(m_Pixels.data(), m_Transposed.data(), width, height, radius, context);
+            BlurRowsTransposed(m_Transposed.data(), m_Pixels.data(), height, width, radius, context);
+
+            if (context.IsCancelled())
+            {
+                return;
+            }
+
+            // Each band covers one row of tiles of the destination, so threads never write to the same tile.
+            int bandCount = (height + Bitmap::TileSize - 1) / Bitmap::TileSize;
+
+            pool.ParallelFor(bandCount, [&](int band) {
+                int firstRow = band * Bitmap::TileSize;
+                int lastRow = std::min(firstRow + Bitmap::TileSize, height);
+
+                for (int y = firstRow; y < lastRow; ++y)
+                {
+                    destination.WriteSpan(0, y, width, &m_Pixels[static_cast<size_t>(y) * width]);
+                }
+            });
+        }
+
+    private:
+        /**
+         * @brief Blurs each of the `rows` rows of `source` and stores row `y` as column `y` of `destination`.
+         *
+         * Each thread that joins claims chunks of rows until none are left, reusing its own pair of rows from
+         * `m_Rows` for all of them.
+         */
+        void BlurRowsTransposed(const ColorRGBA* source, ColorRGBA* destination, int length, int rows, float radius, const EffectContext& context)
+        {
+            ThreadPool& pool = ThreadPool::GetShared();
+
+            int chunkSize = 16;
+            int chunkCount = (rows + chunkSize - 1) / chunkSize;
+
+            int threadCount = std::min(static_cast<int>(pool.GetThreadCount()) + 1, chunkCount);
+
+            std::vector<float> kernel;
+            std::vector<int> boxRadii;
+
+            if (radius <= DirectKernelMaxRadius)
+            {
+                kernel = CreateKernel(radius);
+            }
+            else
+            {
+                boxRadii = CreateBoxRadii(radius, 3);
+            }
+
+            m_Rows.resize(static_cast<size_t>(threadCount) * 2 * length);
+
+            std::atomic<int> nextChunk(0);
+
+            pool.ParallelFor(threadCount, [&](int thread) {
+                ColorRGBA* front = &m_Rows[static_cast<size_t>(thread) * 2 * length];
+                ColorRGBA* back = front + length;
+
+                int chunk;
+
+                while ((chunk = nextChunk.fetch_add(1)) < chunkCount)
+                {
+                    if (context.IsCancelled())
+                    {
+                        return;
+                    }
+
+                    int firstRow = chunk * chunkSize;
+                    int lastRow = std::min(firstRow + chunkSize, rows);
+
+                    for (int y = firstRow; y < lastRow; ++y)
+                    {
+                        const ColorRGBA* row = source + static_cast<size_t>(y) * length;
+
+                        if (!kernel.empty())
+                        {
+                            Convolve(row, front, length, kernel);
+                        }
+                        else
+                        {
+                            BoxBlur(row, front, length, boxRadii[0]);
+
+                            for (size_t i = 1; i < boxRadii.size(); ++i)
+                            {
+                                BoxBlur(front, back, length, boxRadii[i]);
+                                std::swap(front, back);
+                            }
+                        }
+
+                        for (int x = 0; x < length; ++x)
+                        {
+                            destination[static_cast<size_t>(x) * rows + y] = front[x];
+                        }
+                    }
+
+                    context.CompleteRows(lastRow - firstRow);
+                }
+            });
+        }
+
+        static std::vector<float> CreateKernel(float sigma)
+        {
+            int kernelSize = 2 * std::max(1, static_cast<int>(2.0f * sigma)) + 1;
+            int halfSize = kernelSize / 2;
+
+            std::vector<float> kernel(kernelSize);
+            float sum = 0.0f;
+
+            for (int i = 0; i < kernelSize; i++)
+            {
+                float x = i - halfSize;
+                kernel[i] = std::exp(-(x * x) / (2 * sigma * sigma));
+                sum += kernel[i];
+            }
+
+            for (int i = 0; i < kernelSize; i++)
+            {
+                kernel[i] /= sum;
+            }
+
+            return kernel;
+        }
+
+        /**
+         * @brief Computes the radii of `passes` box blurs whose composition approximates a Gaussian of the given sigma.
+         */
+        static std::vector<int> CreateBoxRadii(float sigma, int passes)
+        {
+            float idealWidth = std::sqrt(12.0f * sigma * sigma / passes + 1.0f);
+
+            int lowerWidth = static_cast<int>(std::floor(idealWidth));
+
+            if (lowerWidth % 2 == 0)
+            {
+                lowerWidth--;
+            }
+
+            int upperWidth = lowerWidth + 2;
+
+            float idealLowerCount = (12.0f * sigma * sigma - passes * lowerWidth * lowerWidth - 4.0f * passes * lowerWidth - 3.0f * passes) / (-4.0f * lowerWidth - 4.0f);
+            int lowerCount = static_cast<int>(std::round(idealLowerCount));
+
+            std::vector<int> radii(passes);
+
+            for (int i = 0; i < passes; ++i)
+            {
+                radii[i] = ((i < lowerCount ? lowerWidth : upperWidth) - 1) / 2;
+            }
+
+            return radii;
+        }
+
+        static void Convolve(const ColorRGBA* source, ColorRGBA* destination, int length, const std::vector<float>& kernel)
+        {
+            int halfSize = static_cast<int>(kernel.size()) / 2;
+
+            for (int x = 0; x < length; ++x)
+            {
+                ColorRGBA color(0.0f, 0.0f, 0.0f, 0.0f);
+
+                for (int i = 0; i < static_cast<int>(kernel.size()); ++i)
+                {
+                    int sampleX = Clamp(x + i - halfSize, 0, length - 1);
+                    color += source[sampleX] * kernel[i];
+                }
+
+                destination[x] = color;
+            }
+        }
+
+        /**
+         * @brief Averages a window of `2 * radius + 1` pixels around each pixel, repeating the edge pixels.
+         */
+        static void BoxBlur(const ColorRGBA* source, ColorRGBA* destination, int length, int radius)
+        {
+            if (radius <= 0)
+            {
+                std::copy(source, source + length, destination);
+                return;
+            }
+
+            float scale = 1.0f / (2 * radius + 1);
+            int last = length - 1;
+
+            ColorRGBA sum = source[0] * static_cast<float>(radius + 1);
+
+            for (int i = 1; i <= radius; ++i)
+            {
+                sum += source[std::min(i, last)];
+            }
+
+            for (int x = 0; x < length; ++x)
+            {
+                destination[x] = sum * scale;
+
+                sum += source[std::min(x + radius + 1, last)];
+                sum -= source[std::max(x - radius, 0)];
+            }
+        }
+    };
+}
@@ -3,7 +3,9 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <cstdint>
 
+#include "Composite.h"
 #include "Element.h"
 #include "StyleSheet.h"
 
@@ -17,11 +19,26 @@ namespace yap
     /**
      * @class Box
      * @brief Represents a container element that can hold child elements, manage layout, and handle rendering.
+     *
+     * An image background is scaled and composited over its transparency reference into a buffer that is
+     * kept between frames and only rebuilt when the revision of the bitmap, the target size or the
+     * reference change, so drawing an unchanged image costs no pixel work. Images drawn at their own size
+     * only refresh the dirty rectangle of the bitmap.
      */
     class Box : public Element
     {
     private:
         std::shared_ptr<Bitmap> m_BufferBitmap;
+        std::vector<ColorRGBA8> m_BufferPixels;
+        std::vector<ColorRGBA8> m_SourceRow;
+
+        std::shared_ptr<const Bitmap> m_BufferSource;
+        uint64_t m_BufferRevision = 0;
+        int m_BufferWidth = 0;
+        int m_BufferHeight = 0;
+        BoxBackgroundTransparencyReference m_BufferReference;
+
+        std::vector<const Element*> m_RecordedChildren;
 
     public:
         std::vector<std::shared_ptr<Element>> Children;
@@ -393,10 +410,46 @@ namespace yap
 
             for (const auto& child : Children)
             {
-                child->Draw(context);
+                child->Record(context);
             }
         }
 
+        bool UpdateDirty() override
+        {
+            bool dirty = Element::UpdateDirty();
+
+            if (HaveChildrenChanged())
+            {
+                m_RecordedChildren.clear();
+
+                for (const auto& child : Children)
+                {
+                    m_RecordedChildren.push_back(child.get());
+                }
+
+                dirty = true;
+            }
+
+            // Hidden boxes draw nothing, so the state of their children does not matter until they show up.
+            if (ComputedStyle.Visibility)
+            {
+                for (const auto& child : Children)
+                {
+                    if (child->UpdateDirty())
+                    {
+                        dirty = true;
+                    }
+                }
+            }
+
+            if (dirty)
+            {
+                Invalidate();
+            }
+
+            return dirty;
+        }
+
         void AddChild(const std::shared_ptr<Element>& child)
         {
             Children.push_back(child);
@@ -452,7 +505,36 @@ namespace yap
             return Children;
         }
     
+    protected:
+        bool IsContentDirty() const override
+        {
+            // Hidden images are not brought up to date, so only visible ones count.
+            return (
+                ComputedStyle.Visibility &&
+                ComputedStyle.Background.IsImage() &&
+                ComputedStyle.Background.GetBitmap()->GetRevision() != m_BufferRevision
+            );
+        }
+
     private:
+        bool HaveChildrenChanged() const
+        {
+            if (Children.size() != m_RecordedChildren.size())
+            {
+                return true;
+            }
+
+            for (size_t i = 0; i < Children.size(); ++i)
+            {
+                if (Children[i].get() != m_RecordedChildren[i])
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
         Axis GetDirectionPrimaryAxis()
         {
             return (ComputedStyle.Direction == BoxDirection::Row ? Axis::X : Axis::Y);
@@ -471,7 +553,7 @@ namespace yap
 
         void DrawImageBackground(RenderingContext& context)
         {
-            auto bitmap = ComputedStyle.Background.GetBitmap().get();
+            const std::shared_ptr<const Bitmap>& bitmap = ComputedStyle.Background.GetBitmap();
             auto reference = ComputedStyle.BackgroundReference;
 
             Vec2 originalSize = Vec2(bitmap->GetWidth(), bitmap->GetHeight());
@@ -515,49 +597,86 @@ namespace yap
                     break;
             }
 
-            m_BufferBitmap->Reallocate(targetSize.X, targetSize.Y);
+            int width = static_cast<int>(targetSize.X);
+            int height = static_cast<int>(targetSize.Y);
+
+            if (bitmap != m_BufferSource || width != m_BufferWidth || height != m_BufferHeight || reference != m_BufferReference)
+            {
+                m_BufferSource = bitmap;
+                m_BufferWidth = width;
+                m_BufferHeight = height;
+                m_BufferReference = reference;
+
+                m_BufferPixels.resize(static_cast<size_t>(width) * height);
+
+                UpdateImageBuffer(Rect(0, 0, width, height));
+            }
+            else if (bitmap->GetRevision() != m_BufferRevision)
+            {
+                bool scaled = width != bitmap->GetWidth() || height != bitmap->GetHeight();
+
+                UpdateImageBuffer(scaled ? Rect(0, 0, width, height) : bitmap->GetDirtyRect(m_BufferRevision));
+            }
+
+            context.Image(targetPosition, width, height, reinterpret_cast<const unsigned char*>(m_BufferPixels.data()));
+        }
+
+        /**
+         * @brief Recomposites `region` of the buffer from the current pixels of `m_BufferSource`.
+         */
+        void UpdateImageBuffer(const Rect& region)
+        {
+            const Bitmap& bitmap = *m_BufferSource;
+            const BoxBackgroundTransparencyReference& reference = m_BufferReference;
+
+            m_BufferRevision = bitmap.GetRevision();
 
-            Bitmap::Scale(*bitmap, *m_BufferBitmap);
+            int width = m_BufferWidth;
+            const Bitmap* scaled = &bitmap;
 
-            if (reference.IsStatic())
+            if (width != bitmap.GetWidth() || m_BufferHeight != bitmap.GetHeight())
             {
-                context.Color(reference.GetStaticColor());
-                context.FillRectangle(targetPosition, targetSize);
+                m_BufferBitmap->Reallocate(width, m_BufferHeight);
+                Bitmap::Scale(bitmap, *m_BufferBitmap);
+
+                scaled = m_BufferBitmap.get();
             }
 
-            for (int x = 0; x < m_BufferBitmap->GetWidth(); x++)
+            m_SourceRow.resize(region.Width);
+
+            for (int y = region.GetTop(); y < region.GetBottom(); y++)
             {
-                for (int y = 0; y < m_BufferBitmap->GetHeight(); y++)
+                ColorRGBA8* row = &m_BufferPixels[static_cast<size_t>(y) * width + region.X];
+
+                switch (reference.GetMode())
                 {
-                    const ColorRGBA& pixelColor = m_BufferBitmap->GetPixel(x, y);
+                    case BoxBackgroundTransparencyMode::Static:
+                        std::fill(row, row + region.Width, ColorRGBA8(ColorRGBA(reference.GetStaticColor())));
+                        break;
+                    case BoxBackgroundTransparencyMode::Checkerboard:
+                        {
+                            int checkerboardSize = reference.GetCheckerboardSize();
 
-                    switch (ComputedStyle.BackgroundReference.GetMode())
-                    {
-                        case BoxBackgroundTransparencyMode::Static:
-                            if (pixelColor.A != 0.0f)
-                            {
-                                context.Color(pixelColor.CompositeOver(ComputedStyle.BackgroundReference.GetStaticColor()));
-                                context.FillPoint(targetPosition + Vec2(x, y));
-                            }
-                            break;
-                        case BoxBackgroundTransparencyMode::Checkerboard:
-                            {
-                                int checkerboardSize = ComputedStyle.BackgroundReference.GetCheckerboardSize();
+                            ColorRGBA8 oddColor(ColorRGBA(reference.GetCheckerboardOddColor()));
+                            ColorRGBA8 evenColor(ColorRGBA(reference.GetCheckerboardEvenColor()));
 
-                                int checkerboardX = x / checkerboardSize;
-                                int checkerboardY = y / checkerboardSize;
+                            int checkerboardY = y / checkerboardSize;
 
-                                ColorRGB checkerboardColor = (checkerboardX + checkerboardY) % 2 ?
-                                    ComputedStyle.BackgroundReference.GetCheckerboardOddColor() :
-                                    ComputedStyle.BackgroundReference.GetCheckerboardEvenColor();
-                                
-                                context.Color(pixelColor.CompositeOver(checkerboardColor));
-                                context.FillPoint(targetPosition + Vec2(x, y));
+                            for (int x = 0; x < region.Width; x++)
+                            {
+                                int checkerboardX = (region.X + x) / checkerboardSize;
+                                row[x] = (checkerboardX + checkerboardY) % 2 ? oddColor : evenColor;
                             }
-                            break;
-                    }
+                        }
+                        break;
                 }
+
+                scaled->ReadSpan(region.X, y, region.Width, m_SourceRow.data());
+                Composite::SourceOver(m_SourceRow.data(), row, region.Width);
             }
+
+            // The composited pixels are all that is kept, so the scaled tiles can go.
+            m_BufferBitmap->Clear();
         }
     };
 }
\ No newline at end of file
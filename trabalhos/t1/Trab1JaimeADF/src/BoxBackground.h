@@ -49,6 +49,16 @@ namespace yap
             return m_Size;
         }
 
+        bool operator==(const BoxBackgroundSizingRule &other) const
+        {
+            return m_Mode == other.m_Mode && m_Size == other.m_Size;
+        }
+
+        bool operator!=(const BoxBackgroundSizingRule &other) const
+        {
+            return !(*this == other);
+        }
+
         static BoxBackgroundSizingRule Fixed(const Vec2 &size)
         {
             return BoxBackgroundSizingRule(BoxBackgroundSizingMode::Fixed, size);
@@ -102,6 +112,16 @@ namespace yap
             return m_Position;
         }
 
+        bool operator==(const BoxBackgroundPositioningRule &other) const
+        {
+            return m_Mode == other.m_Mode && m_Position == other.m_Position;
+        }
+
+        bool operator!=(const BoxBackgroundPositioningRule &other) const
+        {
+            return !(*this == other);
+        }
+
         static BoxBackgroundPositioningRule Fixed(const Vec2 &position)
         {
             return BoxBackgroundPositioningRule(BoxBackgroundPositioningMode::Fixed, position);
@@ -143,10 +163,20 @@ namespace yap
 
     public:
         BoxBackgroundTransparencyReference()
-            : m_Mode(BoxBackgroundTransparencyMode::Static), m_Color1(1.0f, 1.0f, 1.0f), m_Color2()
+            : m_Mode(BoxBackgroundTransparencyMode::Static), m_Color1(1.0f, 1.0f, 1.0f), m_Color2(), m_Size(0)
         {
         }
 
+        bool operator==(const BoxBackgroundTransparencyReference& other) const
+        {
+            return m_Mode == other.m_Mode && m_Color1 == other.m_Color1 && m_Color2 == other.m_Color2 && m_Size == other.m_Size;
+        }
+
+        bool operator!=(const BoxBackgroundTransparencyReference& other) const
+        {
+            return !(*this == other);
+        }
+
         BoxBackgroundTransparencyMode GetMode() const
         {
             return m_Mode;
@@ -257,6 +287,16 @@ namespace yap
             return m_Bitmap;
         }
 
+        bool operator==(const BoxBackground &other) const
+        {
+            return m_Kind == other.m_Kind && m_Color == other.m_Color && m_Bitmap == other.m_Bitmap;
+        }
+
+        bool operator!=(const BoxBackground &other) const
+        {
+            return !(*this == other);
+        }
+
         static BoxBackground Solid(const ColorRGB &color)
         {
             return BoxBackground(BoxBackgroundKind::Solid, color, nullptr);
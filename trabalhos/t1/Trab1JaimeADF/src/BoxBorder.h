@@ -62,6 +62,16 @@ namespace yap
             return m_Width;
         }
 
+        bool operator==(const BoxBorder &other) const
+        {
+            return m_Kind == other.m_Kind && m_Color == other.m_Color && m_Width == other.m_Width;
+        }
+
+        bool operator!=(const BoxBorder &other) const
+        {
+            return !(*this == other);
+        }
+
         static BoxBorder Solid(const ColorRGB &color, float width = 1.0f)
         {
             return BoxBorder(BoxBorderKind::Solid, color, width);
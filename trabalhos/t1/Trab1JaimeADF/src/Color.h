@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "Math.h"
 
 /**
@@ -12,6 +14,7 @@ namespace yap
 {
     class ColorRGB;
     class ColorRGBA;
+    class ColorRGBA8;
     class ColorHSV;
     class ColorHSVA;
 
@@ -344,6 +347,44 @@ namespace yap
         }
     };
 
+    /**
+     * @class ColorRGBA8
+     * @brief Packed 8-bit per channel RGBA color, used as compact pixel storage.
+     */
+    class ColorRGBA8
+    {
+    public:
+        uint8_t R, G, B, A;
+
+        ColorRGBA8() : R(0), G(0), B(0), A(0) {}
+        ColorRGBA8(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255) : R(r), G(g), B(b), A(a) {}
+
+        explicit ColorRGBA8(const ColorRGBA& color)
+            : R(Quantize(color.R)), G(Quantize(color.G)), B(Quantize(color.B)), A(Quantize(color.A))
+        {
+        }
+
+        ColorRGBA ToRGBA() const
+        {
+            return ColorRGBA(R / 255.0f, G / 255.0f, B / 255.0f, A / 255.0f);
+        }
+
+        bool operator==(const ColorRGBA8& other) const
+        {
+            return R == other.R && G == other.G && B == other.B && A == other.A;
+        }
+
+        bool operator!=(const ColorRGBA8& other) const
+        {
+            return !(*this == other);
+        }
+
+        static uint8_t Quantize(float value)
+        {
+            return static_cast<uint8_t>(yap::Clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    };
+
     class ColorHSVA : public ColorHSV
     {
     public:
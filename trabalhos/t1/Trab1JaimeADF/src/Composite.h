@@ -0,0 +1,303 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Color.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define YAP_COMPOSITE_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @file Composite.h
+ * @brief Provides span-level "source-over" compositing kernels with SIMD implementations selected at runtime.
+ */
+
+namespace yap
+{
+    static_assert(sizeof(ColorRGBA) == 4 * sizeof(float), "ColorRGBA must be tightly packed");
+    static_assert(sizeof(ColorRGBA8) == 4, "ColorRGBA8 must be tightly packed");
+
+    /**
+     * @enum CompositeKernel
+     * @brief Identifies the instruction set used by the compositing kernels.
+     */
+    enum class CompositeKernel
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * @class Composite
+     * @brief Blends rows of straight-alpha source pixels over a destination row.
+     *
+     * The kernels follow `ColorRGBA::CompositeOver`: `rgb = src.rgb * src.a + dst.rgb * (1 - src.a)` and
+     * `a = src.a + dst.a * (1 - src.a)`. The source is straight alpha, while the destination accumulates a
+     * premultiplied result, which is exactly what compositing a stack of layers over transparency needs.
+     * The float kernels reproduce `CompositeOver` bit for bit; the 8-bit kernels round each channel to the
+     * nearest integer.
+     *
+     * The fastest kernel supported by the running CPU is picked on first use and can be overridden, which
+     * the benchmarks use to compare implementations.
+     */
+    class Composite
+    {
+    public:
+        static void SourceOver(const ColorRGBA* source, ColorRGBA* destination, int count)
+        {
+            switch (GetKernel())
+            {
+#ifdef YAP_COMPOSITE_X86
+                case CompositeKernel::AVX2:
+                    SourceOverAVX2(source, destination, count);
+                    break;
+                case CompositeKernel::SSE2:
+                    SourceOverSSE2(source, destination, count);
+                    break;
+#endif
+                default:
+                    SourceOverScalar(source, destination, count);
+                    break;
+            }
+        }
+
+        static void SourceOver(const ColorRGBA8* source, ColorRGBA8* destination, int count)
+        {
+            switch (GetKernel())
+            {
+#ifdef YAP_COMPOSITE_X86
+                case CompositeKernel::AVX2:
+                    SourceOverAVX2(source, destination, count);
+                    break;
+                case CompositeKernel::SSE2:
+                    SourceOverSSE2(source, destination, count);
+                    break;
+#endif
+                default:
+                    SourceOverScalar(source, destination, count);
+                    break;
+            }
+        }
+
+        static CompositeKernel GetKernel()
+        {
+            return GetKernelStorage();
+        }
+
+        /**
+         * @brief Forces a kernel. Kernels the CPU does not support fall back to the best supported one.
+         */
+        static void SetKernel(CompositeKernel kernel)
+        {
+            GetKernelStorage() = IsSupported(kernel) ? kernel : DetectKernel();
+        }
+
+        static bool IsSupported(CompositeKernel kernel)
+        {
+            switch (kernel)
+            {
+#ifdef YAP_COMPOSITE_X86
+                case CompositeKernel::AVX2:
+                    return __builtin_cpu_supports("avx2");
+                case CompositeKernel::SSE2:
+                    return __builtin_cpu_supports("sse2");
+#endif
+                case CompositeKernel::Scalar:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        static const char* GetKernelName(CompositeKernel kernel)
+        {
+            switch (kernel)
+            {
+                case CompositeKernel::AVX2:
+                    return "AVX2";
+                case CompositeKernel::SSE2:
+                    return "SSE2";
+                default:
+                    return "Scalar";
+            }
+        }
+
+        static void SourceOverScalar(const ColorRGBA* source, ColorRGBA* destination, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                destination[i] = source[i].CompositeOver(destination[i]);
+            }
+        }
+
+        static void SourceOverScalar(const ColorRGBA8* source, ColorRGBA8* destination, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                uint32_t alpha = source[i].A;
+                uint32_t inverseAlpha = 255 - alpha;
+
+                destination[i].R = Divide255(source[i].R * alpha + destination[i].R * inverseAlpha);
+                destination[i].G = Divide255(source[i].G * alpha + destination[i].G * inverseAlpha);
+                destination[i].B = Divide255(source[i].B * alpha + destination[i].B * inverseAlpha);
+                destination[i].A = Divide255(255 * alpha + destination[i].A * inverseAlpha);
+            }
+        }
+
+#ifdef YAP_COMPOSITE_X86
+        __attribute__((target("sse2")))
+        static void SourceOverSSE2(const ColorRGBA* source, ColorRGBA* destination, int count)
+        {
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 alphaLane = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+            for (int i = 0; i < count; ++i)
+            {
+                __m128 src = _mm_loadu_ps(&source[i].R);
+                __m128 dst = _mm_loadu_ps(&destination[i].R);
+
+                __m128 alpha = _mm_shuffle_ps(src, src, _MM_SHUFFLE(3, 3, 3, 3));
+                __m128 factor = _mm_or_ps(_mm_andnot_ps(alphaLane, alpha), _mm_and_ps(alphaLane, one));
+
+                __m128 result = _mm_add_ps(_mm_mul_ps(src, factor), _mm_mul_ps(dst, _mm_sub_ps(one, alpha)));
+
+                _mm_storeu_ps(&destination[i].R, result);
+            }
+        }
+
+        __attribute__((target("avx2")))
+        static void SourceOverAVX2(const ColorRGBA* source, ColorRGBA* destination, int count)
+        {
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 alphaLane = _mm256_castsi256_ps(_mm256_set_epi32(-1, 0, 0, 0, -1, 0, 0, 0));
+
+            int i = 0;
+
+            for (; i + 2 <= count; i += 2)
+            {
+                __m256 src = _mm256_loadu_ps(&source[i].R);
+                __m256 dst = _mm256_loadu_ps(&destination[i].R);
+
+                __m256 alpha = _mm256_permute_ps(src, _MM_SHUFFLE(3, 3, 3, 3));
+                __m256 factor = _mm256_blendv_ps(alpha, one, alphaLane);
+
+                __m256 result = _mm256_add_ps(_mm256_mul_ps(src, factor), _mm256_mul_ps(dst, _mm256_sub_ps(one, alpha)));
+
+                _mm256_storeu_ps(&destination[i].R, result);
+            }
+
+            SourceOverScalar(source + i, destination + i, count - i);
+        }
+
+        __attribute__((target("sse2")))
+        static void SourceOverSSE2(const ColorRGBA8* source, ColorRGBA8* destination, int count)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i full = _mm_set1_epi16(255);
+            const __m128i alphaLane = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+            int i = 0;
+
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i));
+
+                __m128i low = BlendSSE2(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero), full, alphaLane);
+                __m128i high = BlendSSE2(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero), full, alphaLane);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(low, high));
+            }
+
+            SourceOverScalar(source + i, destination + i, count - i);
+        }
+
+        __attribute__((target("avx2")))
+        static void SourceOverAVX2(const ColorRGBA8* source, ColorRGBA8* destination, int count)
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i full = _mm256_set1_epi16(255);
+            const __m256i alphaLane = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+
+            int i = 0;
+
+            for (; i + 8 <= count; i += 8)
+            {
+                __m256i src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+                __m256i dst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i));
+
+                // Unpacking and packing both work within 128-bit lanes, so the pixel order is preserved.
+                __m256i low = BlendAVX2(_mm256_unpacklo_epi8(src, zero), _mm256_unpacklo_epi8(dst, zero), full, alphaLane);
+                __m256i high = BlendAVX2(_mm256_unpackhi_epi8(src, zero), _mm256_unpackhi_epi8(dst, zero), full, alphaLane);
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_packus_epi16(low, high));
+            }
+
+            SourceOverSSE2(source + i, destination + i, count - i);
+        }
+#endif
+
+    private:
+        static CompositeKernel& GetKernelStorage()
+        {
+            static CompositeKernel kernel = DetectKernel();
+            return kernel;
+        }
+
+        static CompositeKernel DetectKernel()
+        {
+            if (IsSupported(CompositeKernel::AVX2))
+            {
+                return CompositeKernel::AVX2;
+            }
+
+            if (IsSupported(CompositeKernel::SSE2))
+            {
+                return CompositeKernel::SSE2;
+            }
+
+            return CompositeKernel::Scalar;
+        }
+
+        /**
+         * @brief Divides a value in `[0, 65025]` by 255, rounding to the nearest integer.
+         */
+        static uint8_t Divide255(uint32_t value)
+        {
+            value += 128;
+            return static_cast<uint8_t>((value + (value >> 8)) >> 8);
+        }
+
+#ifdef YAP_COMPOSITE_X86
+        /**
+         * @brief Blends two pixels widened to 16 bits per channel, using the same rounding as `Divide255`.
+         */
+        __attribute__((target("sse2")))
+        static __m128i BlendSSE2(__m128i src, __m128i dst, __m128i full, __m128i alphaLane)
+        {
+            __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            __m128i factor = _mm_or_si128(_mm_andnot_si128(alphaLane, alpha), _mm_and_si128(alphaLane, full));
+
+            __m128i value = _mm_add_epi16(_mm_mullo_epi16(src, factor), _mm_mullo_epi16(dst, _mm_sub_epi16(full, alpha)));
+
+            value = _mm_add_epi16(value, _mm_set1_epi16(128));
+            return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+        }
+
+        __attribute__((target("avx2")))
+        static __m256i BlendAVX2(__m256i src, __m256i dst, __m256i full, __m256i alphaLane)
+        {
+            __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            __m256i factor = _mm256_blendv_epi8(alpha, full, alphaLane);
+
+            __m256i value = _mm256_add_epi16(_mm256_mullo_epi16(src, factor), _mm256_mullo_epi16(dst, _mm256_sub_epi16(full, alpha)));
+
+            value = _mm256_add_epi16(value, _mm256_set1_epi16(128));
+            return _mm256_srli_epi16(_mm256_add_epi16(value, _mm256_srli_epi16(value, 8)), 8);
+        }
+#endif
+    };
+}
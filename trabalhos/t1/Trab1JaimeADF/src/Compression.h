@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @file Compression.h
+ * @brief Provides the LZ block compressor and the CRC-32 checksum used by the project file format.
+ */
+
+namespace yap
+{
+    /**
+     * @class LZ
+     * @brief A small LZ77 block compressor in the style of LZ4.
+     *
+     * A block is a sequence of `(literals, match)` pairs. Each pair starts with a token whose high nibble is
+     * the number of literals and whose low nibble is the match length minus `MinMatch`; a nibble of 15 is
+     * followed by extra length bytes, added until a byte other than 255. The literals follow the token, then
+     * the match as a 16-bit little-endian offset back into the output. The last pair has literals only.
+     *
+     * Matches are found greedily through a hash table of 4-byte sequences, so compression is fast and
+     * decompression is little more than copying bytes.
+     */
+    class LZ
+    {
+    public:
+        static void Compress(const uint8_t* source, size_t size, std::vector<uint8_t>& destination)
+        {
+            destination.clear();
+            destination.reserve(size + size / 255 + 16);
+
+            std::vector<int32_t> table(static_cast<size_t>(1) << HashBits, -1);
+
+            size_t anchor = 0;
+            size_t position = 0;
+
+            while (position + MinMatch <= size)
+            {
+                uint32_t sequence = Read32(source + position);
+                uint32_t hash = (sequence * 2654435761u) >> (32 - HashBits);
+
+                int32_t candidate = table[hash];
+                table[hash] = static_cast<int32_t>(position);
+
+                if (candidate < 0 || position - candidate > MaxOffset || Read32(source + candidate) != sequence)
+                {
+                    // Skip faster through data that does not compress.
+                    position += 1 + ((position - anchor) >> 6);
+                    continue;
+                }
+
+                size_t length = MinMatch;
+
+                while (position + length < size && source[candidate + length] == source[position + length])
+                {
+                    length++;
+                }
+
+                EmitSequence(destination, source + anchor, position - anchor, position - candidate, length);
+
+                position += length;
+                anchor = position;
+            }
+
+            EmitSequence(destination, source + anchor, size - anchor, 0, 0);
+        }
+
+        /**
+         * @brief Decompresses a block that must expand to exactly `size` bytes, throwing if it is malformed.
+         */
+        static void Decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t size)
+        {
+            const uint8_t* input = source;
+            const uint8_t* inputEnd = source + sourceSize;
+
+            size_t output = 0;
+
+            while (input < inputEnd)
+            {
+                uint8_t token = *input++;
+
+                size_t literalCount = ReadLength(token >> 4, input, inputEnd);
+
+                if (literalCount > static_cast<size_t>(inputEnd - input) || literalCount > size - output)
+                {
+                    throw std::runtime_error("Corrupted compressed data");
+                }
+
+                std::memcpy(destination + output, input, literalCount);
+
+                input += literalCount;
+                output += literalCount;
+
+                if (input == inputEnd)
+                {
+                    break;
+                }
+
+                if (inputEnd - input < 2)
+                {
+                    throw std::runtime_error("Corrupted compressed data");
+                }
+
+                size_t offset = input[0] | (input[1] << 8);
+                input += 2;
+
+                size_t length = ReadLength(token & 0x0F, input, inputEnd) + MinMatch;
+
+                if (offset == 0 || offset > output || length > size - output)
+                {
+                    throw std::runtime_error("Corrupted compressed data");
+                }
+
+                const uint8_t* match = destination + output - offset;
+
+                if (offset >= length)
+                {
+                    std::memcpy(destination + output, match, length);
+                }
+                else
+                {
+                    // The match overlaps the bytes it produces, so it is copied forwards one byte at a time.
+                    for (size_t i = 0; i < length; ++i)
+                    {
+                        destination[output + i] = match[i];
+                    }
+                }
+
+                output += length;
+            }
+
+            if (output != size)
+            {
+                throw std::runtime_error("Corrupted compressed data");
+            }
+        }
+
+    private:
+        static const int HashBits = 14;
+        static const size_t MinMatch = 4;
+        static const size_t MaxOffset = 65535;
+
+        static uint32_t Read32(const uint8_t* data)
+        {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        static void EmitSequence(std::vector<uint8_t>& destination, const uint8_t* literals, size_t literalCount, size_t offset, size_t length)
+        {
+            size_t matchCode = length >= MinMatch ? length - MinMatch : 0;
+
+            destination.push_back(static_cast<uint8_t>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15)));
+
+            WriteLength(destination, literalCount);
+            destination.insert(destination.end(), literals, literals + literalCount);
+
+            if (length == 0)
+            {
+                return;
+            }
+
+            destination.push_back(static_cast<uint8_t>(offset));
+            destination.push_back(static_cast<uint8_t>(offset >> 8));
+
+            WriteLength(destination, matchCode);
+        }
+
+        static void WriteLength(std::vector<uint8_t>& destination, size_t length)
+        {
+            if (length < 15)
+            {
+                return;
+            }
+
+            length -= 15;
+
+            while (length >= 255)
+            {
+                destination.push_back(255);
+                length -= 255;
+            }
+
+            destination.push_back(static_cast<uint8_t>(length));
+        }
+
+        static size_t ReadLength(size_t length, const uint8_t*& input, const uint8_t* inputEnd)
+        {
+            if (length < 15)
+            {
+                return length;
+            }
+
+            uint8_t extra;
+
+            do
+            {
+                if (input == inputEnd)
+                {
+                    throw std::runtime_error("Corrupted compressed data");
+                }
+
+                extra = *input++;
+                length += extra;
+            } while (extra == 255);
+
+            return length;
+        }
+    };
+
+    /**
+     * @class CRC32
+     * @brief Computes the standard CRC-32 (polynomial 0xEDB88320) of a block of bytes.
+     */
+    class CRC32
+    {
+    public:
+        static uint32_t Compute(const uint8_t* data, size_t size, uint32_t crc = 0)
+        {
+            static const std::vector<uint32_t> table = CreateTable();
+
+            crc = ~crc;
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            }
+
+            return ~crc;
+        }
+
+    private:
+        static std::vector<uint32_t> CreateTable()
+        {
+            std::vector<uint32_t> table(256);
+
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t value = i;
+
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+                }
+
+                table[i] = value;
+            }
+
+            return table;
+        }
+    };
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+
+/**
+ * @file EffectContext.h
+ * @brief Defines the EffectContext struct, which describes how an effect is being applied, and the
+ * EffectProgress struct, through which a running effect reports progress and observes cancellation.
+ */
+
+namespace yap
+{
+    /**
+     * @struct EffectProgress
+     * @brief Progress counters and cancellation flag shared between a running effect and its observers.
+     *
+     * Effects count finished rows of work. What a row is depends on the effect (a multi-pass effect may
+     * count the rows of every pass), so observers should only look at `CompletedRows / TotalRows`.
+     */
+    struct EffectProgress
+    {
+        std::atomic<bool> Cancelled;
+        std::atomic<int> CompletedRows;
+        std::atomic<int> TotalRows;
+
+        EffectProgress() : Cancelled(false), CompletedRows(0), TotalRows(0)
+        {
+        }
+
+        float GetFraction() const
+        {
+            int total = TotalRows.load();
+            return total > 0 ? static_cast<float>(CompletedRows.load()) / total : 0.0f;
+        }
+    };
+
+    /**
+     * @struct EffectContext
+     * @brief Describes the conditions under which an effect is applied.
+     */
+    struct EffectContext
+    {
+        /**
+         * @brief Ratio between the size of the source bitmap and the image it stands for.
+         *
+         * Previews apply effects to a downsampled proxy; effects whose parameters are measured in pixels
+         * multiply them by this factor so the proxy looks like the full-resolution result scaled down.
+         */
+        float Scale = 1.0f;
+
+        /**
+         * @brief Optional progress tracking. When set, effects should check for cancellation between rows
+         * and return early, leaving the destination partially written.
+         */
+        EffectProgress* Progress = nullptr;
+
+        bool IsCancelled() const
+        {
+            return Progress && Progress->Cancelled.load(std::memory_order_relaxed);
+        }
+
+        void BeginRows(int totalRows) const
+        {
+            if (Progress)
+            {
+                Progress->CompletedRows = 0;
+                Progress->TotalRows = totalRows;
+            }
+        }
+
+        void CompleteRows(int rows = 1) const
+        {
+            if (Progress)
+            {
+                Progress->CompletedRows.fetch_add(rows, std::memory_order_relaxed);
+            }
+        }
+    };
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Bitmap.h"
+#include "EffectContext.h"
+#include "Effects.h"
+#include "Profiler.h"
+#include "Screen.h"
+#include "ThreadPool.h"
+
+/**
+ * @file EffectJob.h
+ * @brief Defines the EffectJob class, which applies an effect to a bitmap on a background thread.
+ */
+
+namespace yap
+{
+    /**
+     * @class EffectJob
+     * @brief Applies a snapshot of an effect to a bitmap without blocking the UI thread.
+     *
+     * The job clones the effect when it is created, so the original can keep being edited while the job
+     * runs. The work happens on its own thread, since the shared pool may have no workers on machines with
+     * a single core; the effect is still free to split its work over the pool. When the result is ready,
+     * `OnComplete` is called on the UI thread through `Screen::ExecuteNextFrame`, unless the job was
+     * cancelled in the meantime, in which case the partial result is discarded.
+     *
+     * The thread belongs to the job: `Cancel` and the destructor wait for it to stop, which the effect does
+     * at its next chunk of rows. Jobs still running when the program exits are cancelled and joined before
+     * the shared pool and the profiler they use are destroyed.
+     */
+    class EffectJob : public std::enable_shared_from_this<EffectJob>
+    {
+    private:
+        std::shared_ptr<Effect> m_Effect;
+        std::shared_ptr<const Bitmap> m_Source;
+
+        Bitmap m_Result;
+
+        EffectContext m_Context;
+        EffectProgress m_Progress;
+
+        bool m_Completed = false;
+
+        std::thread m_Thread;
+
+        struct Registry
+        {
+            std::mutex Mutex;
+            std::set<EffectJob*> Jobs;
+        };
+
+    public:
+        std::function<void(EffectJob&)> OnComplete;
+
+        EffectJob(const Effect& effect, const std::shared_ptr<const Bitmap>& source, float scale = 1.0f)
+            : m_Effect(effect.Clone()), m_Source(source)
+        {
+            m_Effect->OnUpdate = nullptr;
+
+            m_Context.Scale = scale;
+            m_Context.Progress = &m_Progress;
+        }
+
+        ~EffectJob()
+        {
+            Cancel();
+
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Mutex);
+
+            registry.Jobs.erase(this);
+        }
+
+        EffectJob(const EffectJob&) = delete;
+        EffectJob& operator=(const EffectJob&) = delete;
+
+        void Start(const std::shared_ptr<Screen>& screen)
+        {
+            {
+                Registry& registry = GetRegistry();
+                std::lock_guard<std::mutex> lock(registry.Mutex);
+
+                registry.Jobs.insert(this);
+            }
+
+            std::weak_ptr<EffectJob> weakSelf = shared_from_this();
+
+            m_Thread = std::thread([this, weakSelf, screen]() {
+                Profiler::Get().SetThreadName("Effect job");
+
+                {
+                    ProfileScope scope("EffectJob::Apply");
+                    m_Effect->Apply(*m_Source, m_Result, m_Context);
+                }
+
+                if (IsCancelled())
+                {
+                    return;
+                }
+
+                // The job may be gone by the next frame, in which case there is nothing to report.
+                screen->ExecuteNextFrame([weakSelf]() {
+                    auto self = weakSelf.lock();
+
+                    if (!self || self->IsCancelled())
+                    {
+                        return;
+                    }
+
+                    self->m_Completed = true;
+
+                    if (self->OnComplete)
+                    {
+                        self->OnComplete(*self);
+                    }
+                });
+            });
+        }
+
+        /**
+         * @brief Stops the job and waits for its thread to finish. Must not be called from the job itself.
+         */
+        void Cancel()
+        {
+            m_Progress.Cancelled = true;
+
+            if (m_Thread.joinable())
+            {
+                m_Thread.join();
+            }
+        }
+
+        bool IsCancelled() const
+        {
+            return m_Progress.Cancelled.load();
+        }
+
+        /**
+         * @brief Whether the result is available. Only meaningful on the UI thread.
+         */
+        bool IsCompleted() const
+        {
+            return m_Completed;
+        }
+
+        float GetProgress() const
+        {
+            return m_Progress.GetFraction();
+        }
+
+        /**
+         * @brief Returns the result. Must only be used once the job has completed.
+         */
+        Bitmap& GetResult()
+        {
+            return m_Result;
+        }
+
+    private:
+        /**
+         * @brief Returns the jobs that have been started and not destroyed yet. The registry is never
+         * destroyed, so jobs can leave it at any time; the jobs in it are stopped by an exit handler.
+         */
+        static Registry& GetRegistry()
+        {
+            static Registry* registry = CreateRegistry();
+
+            return *registry;
+        }
+
+        static Registry* CreateRegistry()
+        {
+            // Exit handlers run before the destructors of statics constructed earlier, so the pool and the
+            // profiler are constructed first to outlive the jobs.
+            ThreadPool::GetShared();
+            Profiler::Get();
+
+            std::atexit(CancelAll);
+
+            return new Registry();
+        }
+
+        static void CancelAll()
+        {
+            Registry& registry = GetRegistry();
+            std::vector<EffectJob*> jobs;
+
+            {
+                std::lock_guard<std::mutex> lock(registry.Mutex);
+                jobs.assign(registry.Jobs.begin(), registry.Jobs.end());
+            }
+
+            for (EffectJob* job : jobs)
+            {
+                job->Cancel();
+            }
+        }
+    };
+}
@@ -2,6 +2,8 @@
 
 #include "Modal.h"
 #include "Effects.h"
+#include "EffectJob.h"
+#include "Profiler.h"
 
 /**
  * @file EffectModal.h
@@ -17,11 +19,18 @@ namespace yap
     class EffectModal : public Modal
     {
     private:
+        static constexpr double ProgressRefreshInterval = 0.1;
+
         std::shared_ptr<Project> m_Project;
         std::shared_ptr<Layer> m_WorkLayer;
 
+        std::shared_ptr<Bitmap> m_ProxyBitmap;
         std::shared_ptr<Bitmap> m_PreviewBitmap;
 
+        float m_ProxyScale = 1.0f;
+
+        Vec2 m_PreviewSize;
+
         std::vector<std::shared_ptr<Effect>> m_Effects;
 
         int m_CurrentEffectIndex = -1;
@@ -29,6 +38,11 @@ namespace yap
         std::shared_ptr<Box> m_CurrentEffectOptions;
         std::shared_ptr<Text> m_CurrentEffectName;
 
+        std::shared_ptr<Text> m_ProgressText;
+
+        std::shared_ptr<EffectJob> m_Job;
+        bool m_ApplyPending = false;
+
     public:
         EffectModal(const std::shared_ptr<Project>& project) : m_Project(project)
         {
@@ -43,11 +57,14 @@ namespace yap
                 std::make_shared<RandomNoiseEffect>()
             };
 
+            m_ProxyBitmap = std::make_shared<Bitmap>();
             m_PreviewBitmap = std::make_shared<Bitmap>();
 
             m_CurrentEffectOptions = std::make_shared<Box>();
             m_CurrentEffectName = std::make_shared<Text>();
 
+            m_ProgressText = std::make_shared<Text>();
+
             auto header = CreateHeader("Efeitos");
             auto body = CreateBody();
 
@@ -58,6 +75,8 @@ namespace yap
 
             if (m_WorkLayer)
             {
+                CreateProxyBitmap();
+
                 auto preview = std::make_shared<Box>();
 
                 auto carousel = std::make_shared<Box>();
@@ -88,28 +107,11 @@ namespace yap
 
                 preview->OnAnimate = [this](Element& element)
                 {
-                    int maximumWidth = 384;
-                    int maximumHeight = 216;
-
-                    int layerWidth = m_WorkLayer->GetBitmap()->GetWidth();
-                    int layerHeight = m_WorkLayer->GetBitmap()->GetHeight();
-
-                    float aspectRatio = static_cast<float>(layerWidth) / static_cast<float>(layerHeight);
-
-                    int previewWidth = maximumWidth;
-                    int previewHeight = static_cast<int>(maximumWidth / aspectRatio);
-
-                    if (previewHeight > maximumHeight)
-                    {
-                        previewHeight = maximumHeight;
-                        previewWidth = static_cast<int>(maximumHeight * aspectRatio);
-                    }
-
                     element.SetStyle(
                         element.GetStyle()
                             .WithSize(
-                                AxisSizingRule::Fixed(previewWidth),
-                                AxisSizingRule::Fixed(previewHeight)
+                                AxisSizingRule::Fixed(m_PreviewSize.X),
+                                AxisSizingRule::Fixed(m_PreviewSize.Y)
                             )
                     );
                 };
@@ -150,8 +152,31 @@ namespace yap
 
                 applyButton->OnMousePress = [this](Element& element)
                 {
-                    m_WorkLayer->SetBitmap(*m_PreviewBitmap);
-                    Close();
+                    if (m_Job && m_Job->IsCompleted())
+                    {
+                        ApplyResult();
+                    }
+                    else
+                    {
+                        m_ApplyPending = true;
+                    }
+                };
+
+                m_ProgressText->OnAnimate = [this](Element& element)
+                {
+                    if (m_Job && !m_Job->IsCompleted())
+                    {
+                        int percentage = static_cast<int>(m_Job->GetProgress() * 100.0f);
+
+                        m_ProgressText->Content = (m_ApplyPending ? "Aplicando: " : "Processando: ") + std::to_string(percentage) + "%";
+
+                        // The job reports its completion itself, but not its progress.
+                        element.GetScreen()->RequestFrameAfter(ProgressRefreshInterval);
+                    }
+                    else
+                    {
+                        m_ProgressText->Content = "";
+                    }
                 };
 
                 buttons->SetStyle(
@@ -171,6 +196,7 @@ namespace yap
 
                 body->AddChild(carousel);
                 body->AddChild(preview);
+                body->AddChild(m_ProgressText);
                 body->AddChild(m_CurrentEffectOptions);
                 body->AddChild(buttons);
             } 
@@ -194,7 +220,65 @@ namespace yap
             AddChild(body);
         }
 
+        void Unmount() override
+        {
+            CancelJob();
+            Modal::Unmount();
+        }
+
     private:
+        /**
+         * @brief Sizes the preview box and downsamples the work layer to fit it.
+         *
+         * Effects are previewed on this proxy, so adjusting parameters costs the same regardless of the
+         * size of the layer. The full-resolution result is computed in the background by `StartJob`.
+         */
+        void CreateProxyBitmap()
+        {
+            const int maximumWidth = 384;
+            const int maximumHeight = 216;
+
+            auto layerBitmap = m_WorkLayer->GetBitmap();
+
+            int layerWidth = layerBitmap->GetWidth();
+            int layerHeight = layerBitmap->GetHeight();
+
+            if (layerWidth == 0 || layerHeight == 0)
+            {
+                m_ProxyBitmap->Reallocate(0, 0, layerBitmap->GetFormat());
+                m_PreviewSize = Vec2();
+                return;
+            }
+
+            float aspectRatio = static_cast<float>(layerWidth) / static_cast<float>(layerHeight);
+
+            int previewWidth = maximumWidth;
+            int previewHeight = static_cast<int>(maximumWidth / aspectRatio);
+
+            if (previewHeight > maximumHeight)
+            {
+                previewHeight = maximumHeight;
+                previewWidth = static_cast<int>(maximumHeight * aspectRatio);
+            }
+
+            previewWidth = std::max(1, previewWidth);
+            previewHeight = std::max(1, previewHeight);
+
+            m_PreviewSize = Vec2(previewWidth, previewHeight);
+
+            if (previewWidth >= layerWidth)
+            {
+                *m_ProxyBitmap = *layerBitmap;
+                m_ProxyScale = 1.0f;
+                return;
+            }
+
+            m_ProxyBitmap->Reallocate(previewWidth, previewHeight, layerBitmap->GetFormat());
+            Bitmap::Scale(*layerBitmap, *m_ProxyBitmap, ScalingMethod::Bilinear);
+
+            m_ProxyScale = static_cast<float>(previewWidth) / static_cast<float>(layerWidth);
+        }
+
         void NextEffect()
         {
             SelectEffect(m_CurrentEffectIndex + 1);
@@ -216,10 +300,12 @@ namespace yap
 
             RefreshCurrentEffectDetails();
             RenderCurrentEffectPreviewBitmap();
+            StartJob();
 
             m_Effects[m_CurrentEffectIndex]->OnUpdate = [this](Effect& effect)
             {
                 RenderCurrentEffectPreviewBitmap();
+                StartJob();
             };
         }
 
@@ -234,7 +320,70 @@ namespace yap
         {
             auto effect = m_Effects[m_CurrentEffectIndex];
 
-            effect->Apply(*m_WorkLayer->GetBitmap(), *m_PreviewBitmap);
+            EffectContext context;
+            context.Scale = m_ProxyScale;
+
+            ProfileScope scope("EffectModal::RenderPreview");
+            effect->Apply(*m_ProxyBitmap, *m_PreviewBitmap, context);
+        }
+
+        /**
+         * @brief Cancels the running job, if any, and starts computing the current effect at full resolution.
+         *
+         * Once the job completes, its result replaces the proxy preview, or is applied to the layer if the
+         * user already pressed the apply button.
+         */
+        void StartJob()
+        {
+            CancelJob();
+
+            if (!GetScreen())
+            {
+                return;
+            }
+
+            m_Job = std::make_shared<EffectJob>(*m_Effects[m_CurrentEffectIndex], m_WorkLayer->GetBitmap());
+
+            m_Job->OnComplete = [this](EffectJob& job)
+            {
+                if (m_ApplyPending)
+                {
+                    ApplyResult();
+                    return;
+                }
+
+                if (m_ProxyScale < 1.0f)
+                {
+                    m_PreviewBitmap->Reallocate(m_ProxyBitmap->GetWidth(), m_ProxyBitmap->GetHeight(), job.GetResult().GetFormat());
+                    Bitmap::Scale(job.GetResult(), *m_PreviewBitmap, ScalingMethod::Bilinear);
+                }
+                else
+                {
+                    *m_PreviewBitmap = job.GetResult();
+                }
+            };
+
+            m_Job->Start(GetScreen());
+        }
+
+        void CancelJob()
+        {
+            if (m_Job)
+            {
+                m_Job->Cancel();
+                m_Job.reset();
+            }
+        }
+
+        void ApplyResult()
+        {
+            m_Project->GetHistory().Begin(m_WorkLayer);
+            m_WorkLayer->SetBitmap(m_Job->GetResult());
+            m_Project->GetHistory().Commit();
+
+            m_ApplyPending = false;
+
+            Close();
         }
     };
 }
\ No newline at end of file
@@ -3,9 +3,13 @@
 #include <iomanip>
 #include <sstream>
 #include <random>
+#include <vector>
 
 #include "Bitmap.h"
+#include "Blur.h"
+#include "EffectContext.h"
 #include "Box.h"
+#include "Slider.h"
 #include "Text.h"
 
 /**
@@ -58,7 +62,22 @@ namespace yap
             return form;
         }
 
-        virtual void Apply(const Bitmap& source, Bitmap& destination) = 0;
+        /**
+         * @brief Applies the effect at full scale, without progress tracking. Subclasses bring it back into
+         * scope with `using Effect::Apply`, since overriding the other overload hides it.
+         */
+        void Apply(const Bitmap& source, Bitmap& destination)
+        {
+            Apply(source, destination, EffectContext());
+        }
+
+        virtual void Apply(const Bitmap& source, Bitmap& destination, const EffectContext& context) = 0;
+
+        /**
+         * @brief Copies the effect with its current parameters, so it can be applied on another thread while
+         * the original keeps being edited.
+         */
+        virtual std::shared_ptr<Effect> Clone() const = 0;
 
     protected:
         std::shared_ptr<Box> CreateForm()
@@ -176,6 +195,16 @@ namespace yap
         {
         }
 
+        void SetBrightness(float brightness)
+        {
+            m_Brightness = brightness;
+        }
+
+        void SetContrast(float contrast)
+        {
+            m_Contrast = contrast;
+        }
+
         std::shared_ptr<Box> CreateOptions() override
         {
             auto form = CreateForm();
@@ -215,15 +244,41 @@ namespace yap
             return form;
         }
 
-        void Apply(const Bitmap& source, Bitmap& destination) override
+        std::shared_ptr<Effect> Clone() const override
+        {
+            return std::make_shared<BrightnessContrastEffect>(*this);
+        }
+
+        using Effect::Apply;
+
+        void Apply(const Bitmap& source, Bitmap& destination, const EffectContext& context) override
         {
-            destination.Reallocate(source.GetWidth(), source.GetHeight());
+            destination.Reallocate(source.GetWidth(), source.GetHeight(), source.GetFormat());
+            destination.Clear();
+
+            std::vector<ColorRGBA> row(source.GetWidth());
+
+            context.BeginRows(source.GetHeight());
 
             for (int y = 0; y < source.GetHeight(); ++y)
             {
+                if (context.IsCancelled())
+                {
+                    return;
+                }
+
+                // Transparent pixels stay transparent, so rows that only cross empty tiles are left empty.
+                if (source.IsRegionEmpty(Rect(0, y, source.GetWidth(), 1)))
+                {
+                    context.CompleteRows();
+                    continue;
+                }
+
+                source.ReadSpan(0, y, source.GetWidth(), row.data());
+
                 for (int x = 0; x < source.GetWidth(); ++x)
                 {
-                    ColorRGBA color = source.GetPixel(x, y);
+                    ColorRGBA& color = row[x];
 
                     color.R = Clamp(color.R + m_Brightness, 0.0f, 1.0f);
                     color.G = Clamp(color.G + m_Brightness, 0.0f, 1.0f);
@@ -232,9 +287,11 @@ namespace yap
                     color.R = Clamp((color.R - 0.5f) * (1.0f + m_Contrast) + 0.5f, 0.0f, 1.0f);
                     color.G = Clamp((color.G - 0.5f) * (1.0f + m_Contrast) + 0.5f, 0.0f, 1.0f);
                     color.B = Clamp((color.B - 0.5f) * (1.0f + m_Contrast) + 0.5f, 0.0f, 1.0f);
-
-                    destination.SetPixel(x, y, color);
                 }
+
+                destination.WriteSpan(0, y, source.GetWidth(), row.data());
+
+                context.CompleteRows();
             }
         }
     };
@@ -253,6 +310,11 @@ namespace yap
         {
         }
 
+        void SetGamma(float gamma)
+        {
+            m_Gamma = gamma;
+        }
+
         std::shared_ptr<Box> CreateOptions() override
         {
             auto form = CreateForm();
@@ -277,22 +339,49 @@ namespace yap
             return form;
         }
 
-        void Apply(const Bitmap& source, Bitmap& destination) override
+        std::shared_ptr<Effect> Clone() const override
+        {
+            return std::make_shared<GammaCorrectionEffect>(*this);
+        }
+
+        using Effect::Apply;
+
+        void Apply(const Bitmap& source, Bitmap& destination, const EffectContext& context) override
         {
-            destination.Reallocate(source.GetWidth(), source.GetHeight());
+            destination.Reallocate(source.GetWidth(), source.GetHeight(), source.GetFormat());
+            destination.Clear();
+
+            std::vector<ColorRGBA> row(source.GetWidth());
+
+            context.BeginRows(source.GetHeight());
 
             for (int y = 0; y < source.GetHeight(); ++y)
             {
+                if (context.IsCancelled())
+                {
+                    return;
+                }
+
+                if (source.IsRegionEmpty(Rect(0, y, source.GetWidth(), 1)))
+                {
+                    context.CompleteRows();
+                    continue;
+                }
+
+                source.ReadSpan(0, y, source.GetWidth(), row.data());
+
                 for (int x = 0; x < source.GetWidth(); ++x)
                 {
-                    ColorRGBA color = source.GetPixel(x, y);
+                    ColorRGBA& color = row[x];
 
                     color.R = Clamp(std::pow(color.R, m_Gamma), 0.0f, 1.0f);
                     color.G = Clamp(std::pow(color.G, m_Gamma), 0.0f, 1.0f);
                     color.B = Clamp(std::pow(color.B, m_Gamma), 0.0f, 1.0f);
-
-                    destination.SetPixel(x, y, color);
                 }
+
+                destination.WriteSpan(0, y, source.GetWidth(), row.data());
+
+                context.CompleteRows();
             }
         }
     };
@@ -308,20 +397,49 @@ namespace yap
         {
         }
 
-        void Apply(const Bitmap& source, Bitmap& destination) override
+        std::shared_ptr<Effect> Clone() const override
+        {
+            return std::make_shared<GrayscaleEffect>(*this);
+        }
+
+        using Effect::Apply;
+
+        void Apply(const Bitmap& source, Bitmap& destination, const EffectContext& context) override
         {
-            destination.Reallocate(source.GetWidth(), source.GetHeight());
+            destination.Reallocate(source.GetWidth(), source.GetHeight(), source.GetFormat());
+            destination.Clear();
+
+            std::vector<ColorRGBA> row(source.GetWidth());
+
+            context.BeginRows(source.GetHeight());
 
             for (int y = 0; y < source.GetHeight(); ++y)
             {
+                if (context.IsCancelled())
+                {
+                    return;
+                }
+
+                if (source.IsRegionEmpty(Rect(0, y, source.GetWidth(), 1)))
+                {
+                    context.CompleteRows();
+                    continue;
+                }
+
+                source.ReadSpan(0, y, source.GetWidth(), row.data());
+
                 for (int x = 0; x < source.GetWidth(); ++x)
                 {
-                    ColorRGBA color = source.GetPixel(x, y);
+                    ColorRGBA color = row[x];
 
                     float gray = 0.3f * color.R + 0.59f * color.G + 0.11f * color.B;
 
-                    destination.SetPixel(x, y, ColorRGBA(gray, gray, gray, color.A));
+                    row[x] = ColorRGBA(gray, gray, gray, color.A);
                 }
+
+                destination.WriteSpan(0, y, source.GetWidth(), row.data());
+
+                context.CompleteRows();
             }
         }
     };
@@ -337,15 +455,40 @@ namespace yap
         {
         }
 
-        void Apply(const Bitmap& source, Bitmap& destination) override
+        std::shared_ptr<Effect> Clone() const override
+        {
+            return std::make_shared<SepiaEffect>(*this);
+        }
+
+        using Effect::Apply;
+
+        void Apply(const Bitmap& source, Bitmap& destination, const EffectContext& context) override
         {
-            destination.Reallocate(source.GetWidth(), source.GetHeight());
+            destination.Reallocate(source.GetWidth(), source.GetHeight(), source.GetFormat());
+            destination.Clear();
+
+            std::vector<ColorRGBA> row(source.GetWidth());
+
+            context.BeginRows(source.GetHeight());
 
             for (int y = 0; y < source.GetHeight(); ++y)
             {
+                if (context.IsCancelled())
+                {
+                    return;
+                }
+
+                if (source.IsRegionEmpty(Rect(0, y, source.GetWidth(), 1)))
+                {
+                    context.CompleteRows();
+                    continue;
+                }
+
+                source.ReadSpan(0, y, source.GetWidth(), row.data());
+
                 for (int x = 0; x < source.GetWidth(); ++x)
                 {
-                    ColorRGBA color = source.GetPixel(x, y);
+                    ColorRGBA color = row[x];
 
                     float tr = 0.393f * color.R + 0.769f * color.G + 0.189f * color.B;
                     float tg = 0.349f * color.R + 0.686f * color.G + 0.168f * color.B;
@@ -358,8 +501,12 @@ namespace yap
                         color.A
                     );
 
-                    destination.SetPixel(x, y, sepiaColor);
+                    row[x] = sepiaColor;
                 }
+
+                destination.WriteSpan(0, y, source.GetWidth(), row.data());
+
+                context.CompleteRows();
             }
         }
     };
@@ -373,11 +520,18 @@ namespace yap
     private:
         float m_Radius = 1.0f;
 
+        GaussianBlur m_Blur;
+
     public:
         GaussianBlurEffect() : Effect("Desfoque Gaussiano")
         {
         }
 
+        void SetRadius(float radius)
+        {
+            m_Radius = radius;
+        }
+
         std::shared_ptr<Box> CreateOptions() override
         {
             auto form = CreateForm();
@@ -402,62 +556,16 @@ namespace yap
             return form;
         }
 
-        void Apply(const Bitmap& source, Bitmap& destination) override
-        {
-            destination.Reallocate(source.GetWidth(), source.GetHeight());
-            
-            Bitmap temp(source.GetWidth(), source.GetHeight());
-            
-            int kernelSize = 2 * std::max(1, static_cast<int>(2.0f * m_Radius)) + 1;
-            int halfSize = kernelSize / 2;
-            
-            std::vector<float> kernel(kernelSize);
-            float sigma = m_Radius;
-            float sum = 0.0f;
-            
-            for (int i = 0; i < kernelSize; i++) {
-                float x = i - halfSize;
-                kernel[i] = std::exp(-(x * x) / (2 * sigma * sigma));
-                sum += kernel[i];
-            }
-            
-            for (int i = 0; i < kernelSize; i++) {
-                kernel[i] /= sum;
-            }
-            
-            for (int y = 0; y < source.GetHeight(); ++y) {
-                for (int x = 0; x < source.GetWidth(); ++x) {
-                    ColorRGBA blurredColor(0, 0, 0, 0);
-                    
-                    for (int i = 0; i < kernelSize; ++i) {
-                        int sampleX = x + (i - halfSize);
-                        
-                        sampleX = Clamp(sampleX, 0, source.GetWidth() - 1);
-                        
-                        ColorRGBA sampleColor = source.GetPixel(sampleX, y);
-                        blurredColor += sampleColor * kernel[i];
-                    }
-                    
-                    temp.SetPixel(x, y, blurredColor);
-                }
-            }
-            
-            for (int y = 0; y < temp.GetHeight(); ++y) {
-                for (int x = 0; x < temp.GetWidth(); ++x) {
-                    ColorRGBA blurredColor(0, 0, 0, 0);
-                    
-                    for (int i = 0; i < kernelSize; ++i) {
-                        int sampleY = y + (i - halfSize);
-                        
-                        sampleY = Clamp(sampleY, 0, temp.GetHeight() - 1);
-                        
-                        ColorRGBA sampleColor = temp.GetPixel(x, sampleY);
-                        blurredColor += sampleColor * kernel[i];
-                    }
-                    
-                    destination.SetPixel(x, y, blurredColor);
-                }
-            }
+        std::shared_ptr<Effect> Clone() const override
+        {
+            return std::make_shared<GaussianBlurEffect>(*this);
+        }
+
+        using Effect::Apply;
+
+        void Apply(const Bitmap& source, Bitmap& destination, const EffectContext& context) override
+        {
+            m_Blur.Apply(source, destination, m_Radius * context.Scale, context);
         }
     };
 
@@ -475,6 +583,11 @@ namespace yap
         {
         }
 
+        void SetBlockSize(int blockSize)
+        {
+            m_BlockSize = blockSize;
+        }
+
         std::shared_ptr<Box> CreateOptions() override
         {
             auto form = CreateForm();
@@ -497,20 +610,38 @@ namespace yap
             return form;
         }
 
-        void Apply(const Bitmap& source, Bitmap& destination) override
+        std::shared_ptr<Effect> Clone() const override
+        {
+            return std::make_shared<PixelateEffect>(*this);
+        }
+
+        using Effect::Apply;
+
+        void Apply(const Bitmap& source, Bitmap& destination, const EffectContext& context) override
         {
-            destination.Reallocate(source.GetWidth(), source.GetHeight());
+            destination.Reallocate(source.GetWidth(), source.GetHeight(), source.GetFormat());
+
+            int blockSize = std::max(1, static_cast<int>(std::round(m_BlockSize * context.Scale)));
 
-            for (int y = 0; y < source.GetHeight(); y += m_BlockSize)
+            std::vector<ColorRGBA> row(source.GetWidth());
+
+            context.BeginRows(source.GetHeight());
+
+            for (int y = 0; y < source.GetHeight(); y += blockSize)
             {
-                for (int x = 0; x < source.GetWidth(); x += m_BlockSize)
+                if (context.IsCancelled())
+                {
+                    return;
+                }
+
+                for (int x = 0; x < source.GetWidth(); x += blockSize)
                 {
                     ColorRGBA averageColor = ColorRGBA(0, 0, 0, 0);
                     int count = 0;
 
-                    for (int j = 0; j < m_BlockSize && y + j < source.GetHeight(); ++j)
+                    for (int j = 0; j < blockSize && y + j < source.GetHeight(); ++j)
                     {
-                        for (int i = 0; i < m_BlockSize && x + i < source.GetWidth(); ++i)
+                        for (int i = 0; i < blockSize && x + i < source.GetWidth(); ++i)
                         {
                             averageColor += source.GetPixel(x + i, y + j);
                             count++;
@@ -519,14 +650,16 @@ namespace yap
 
                     averageColor /= static_cast<float>(count);
 
-                    for (int j = 0; j < m_BlockSize && y + j < source.GetHeight(); ++j)
-                    {
-                        for (int i = 0; i < m_BlockSize && x + i < source.GetWidth(); ++i)
-                        {
-                            destination.SetPixel(x + i, y + j, averageColor);
-                        }
-                    }
+                    std::fill(row.begin() + x, row.begin() + std::min(x + blockSize, source.GetWidth()), averageColor);
+                }
+
+                // Every row of the band is the same, so it is built once and written as a whole.
+                for (int j = 0; j < blockSize && y + j < source.GetHeight(); ++j)
+                {
+                    destination.WriteSpan(0, y + j, source.GetWidth(), row.data());
                 }
+
+                context.CompleteRows(std::min(blockSize, source.GetHeight() - y));
             }
         }
     };
@@ -548,6 +681,14 @@ namespace yap
         {
         }
 
+        void SetNoise(float red, float green, float blue, float alpha)
+        {
+            m_RedNoise = red;
+            m_GreenNoise = green;
+            m_BlueNoise = blue;
+            m_AlphaNoise = alpha;
+        }
+
         std::shared_ptr<Box> CreateOptions() override
         {
             auto form = CreateForm();
@@ -621,19 +762,37 @@ namespace yap
             return form;
         }
 
-        void Apply(const Bitmap& source, Bitmap& destination) override
+        std::shared_ptr<Effect> Clone() const override
+        {
+            return std::make_shared<RandomNoiseEffect>(*this);
+        }
+
+        using Effect::Apply;
+
+        void Apply(const Bitmap& source, Bitmap& destination, const EffectContext& context) override
         {
-            destination.Reallocate(source.GetWidth(), source.GetHeight());
+            destination.Reallocate(source.GetWidth(), source.GetHeight(), source.GetFormat());
 
             std::random_device rd;
             std::mt19937 gen(rd());
             std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
 
+            std::vector<ColorRGBA> row(source.GetWidth());
+
+            context.BeginRows(source.GetHeight());
+
             for (int y = 0; y < source.GetHeight(); ++y)
             {
+                if (context.IsCancelled())
+                {
+                    return;
+                }
+
+                source.ReadSpan(0, y, source.GetWidth(), row.data());
+
                 for (int x = 0; x < source.GetWidth(); ++x)
                 {
-                    ColorRGBA color = source.GetPixel(x, y);
+                    ColorRGBA color = row[x];
 
                     float noiseR = dist(gen) * m_RedNoise;
                     float noiseG = dist(gen) * m_GreenNoise;
@@ -647,8 +806,12 @@ namespace yap
                         Clamp(color.A + noiseA, 0.0f, 1.0f)
                     );
 
-                    destination.SetPixel(x, y, noisyColor);
+                    row[x] = noisyColor;
                 }
+
+                destination.WriteSpan(0, y, source.GetWidth(), row.data());
+
+                context.CompleteRows();
             }
         }
     };
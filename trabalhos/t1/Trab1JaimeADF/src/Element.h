@@ -24,6 +24,11 @@ namespace yap
     /**
      * @class Element
      * @brief Represents a UI element that can handle user interactions, animations, and rendering.
+     *
+     * The commands emitted by `Draw` are kept between frames. After style and layout, `UpdateDirty` marks
+     * the element dirty when its appearance, position, size or content changed since they were recorded,
+     * and `Record` only runs `Draw` again for dirty elements; the rest replay their last recording, so a
+     * container whose children did not change splices their commands in without drawing them.
      */
     class Element
     {
@@ -37,6 +42,13 @@ namespace yap
         std::vector<std::pair<std::string, StyleSheet>> m_Styles;
         std::unordered_set<std::string> m_Traits;
 
+        bool m_Dirty = true;
+
+        RenderingContext m_Recording;
+        ComputedStyleSheet m_RecordedStyle;
+        Vec2 m_RecordedPosition;
+        Vec2 m_RecordedSize;
+
     public:
         Vec2 Size = Vec2();
         Vec2 Position = Vec2();
@@ -303,6 +315,58 @@ namespace yap
 
         virtual void Draw(RenderingContext& context) = 0;
 
+        /**
+         * @brief Marks the element dirty if anything it draws changed since its last recording and returns
+         * whether it is dirty. Containers also return true when any of their visible children is.
+         */
+        virtual bool UpdateDirty()
+        {
+            if (
+                !ComputedStyle.HasSameAppearance(m_RecordedStyle) ||
+                Position != m_RecordedPosition ||
+                Size != m_RecordedSize ||
+                IsContentDirty()
+            )
+            {
+                m_Dirty = true;
+            }
+
+            return m_Dirty;
+        }
+
+        /**
+         * @brief Appends the commands of the element to `context`, drawing them again only if it is dirty.
+         */
+        void Record(RenderingContext& context)
+        {
+            if (m_Dirty)
+            {
+                m_Recording.ClearCommands();
+                Draw(m_Recording);
+
+                m_RecordedStyle = ComputedStyle;
+                m_RecordedPosition = Position;
+                m_RecordedSize = Size;
+
+                m_Dirty = false;
+            }
+
+            context.Append(m_Recording);
+        }
+
+        /**
+         * @brief Forces the element to be drawn again on the next frame.
+         */
+        void Invalidate()
+        {
+            m_Dirty = true;
+        }
+
+        bool IsDirty() const
+        {
+            return m_Dirty;
+        }
+
         bool Intersects(const Vec2& point) const
         {
             return (
@@ -422,5 +486,14 @@ namespace yap
         {
             return m_Screen;
         }
+
+    protected:
+        /**
+         * @brief Whether state other than the computed style, position and size changed what `Draw` emits.
+         */
+        virtual bool IsContentDirty() const
+        {
+            return false;
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+
+#include "Layer.h"
+#include "LayerSnapshot.h"
+
+/**
+ * @file History.h
+ * @brief Defines the History class, which records changes to layers so they can be undone and redone.
+ */
+
+namespace yap
+{
+    /**
+     * @class History
+     * @brief A linear undo/redo history of layer changes, bounded by a memory limit.
+     *
+     * A change is recorded by calling `Begin` before touching a layer and `Commit` once done; everything
+     * in between becomes a single step holding a `LayerSnapshot` from before and one from after the change.
+     * Snapshots share tiles with the layer and with each other, so a step only costs the tiles it touched,
+     * and undoing or redoing it only swaps those tiles back.
+     *
+     * When the memory held by the history exceeds the limit, the oldest steps are dropped.
+     */
+    class History
+    {
+    public:
+        static const size_t DefaultMemoryLimit = static_cast<size_t>(256) * 1024 * 1024;
+
+    private:
+        struct Step
+        {
+            std::shared_ptr<Layer> Target;
+
+            LayerSnapshot Before;
+            LayerSnapshot After;
+
+            size_t ByteSize;
+        };
+
+        std::deque<Step> m_Steps;
+        size_t m_Position = 0;
+
+        std::shared_ptr<Layer> m_PendingLayer;
+        LayerSnapshot m_PendingSnapshot;
+
+        size_t m_MemoryLimit;
+
+    public:
+        explicit History(size_t memoryLimit = DefaultMemoryLimit) : m_MemoryLimit(memoryLimit)
+        {
+        }
+
+        /**
+         * @brief Starts recording a change to `layer`, committing the previous change if there is one.
+         */
+        void Begin(const std::shared_ptr<Layer>& layer)
+        {
+            Commit();
+
+            if (!layer)
+            {
+                return;
+            }
+
+            m_PendingLayer = layer;
+            m_PendingSnapshot = layer->TakeSnapshot();
+        }
+
+        /**
+         * @brief Records the change started by `Begin` as a step, unless it left the layer untouched.
+         */
+        void Commit()
+        {
+            if (!m_PendingLayer)
+            {
+                return;
+            }
+
+            std::shared_ptr<Layer> layer = m_PendingLayer;
+            LayerSnapshot before = m_PendingSnapshot;
+
+            m_PendingLayer = nullptr;
+            m_PendingSnapshot = LayerSnapshot();
+
+            LayerSnapshot after = layer->TakeSnapshot();
+
+            if (after.IsSameAs(before))
+            {
+                return;
+            }
+
+            m_Steps.erase(m_Steps.begin() + m_Position, m_Steps.end());
+
+            // A step keeps alive whichever side the layer does not currently show; count the larger one.
+            size_t byteSize = std::max(before.GetByteSizeExcluding(after), after.GetByteSizeExcluding(before));
+
+            m_Steps.push_back({ layer, before, after, byteSize });
+            m_Position = m_Steps.size();
+
+            Trim();
+        }
+
+        bool Undo()
+        {
+            Commit();
+
+            if (!CanUndo())
+            {
+                return false;
+            }
+
+            Step& step = m_Steps[--m_Position];
+            step.Target->Restore(step.Before);
+
+            return true;
+        }
+
+        bool Redo()
+        {
+            Commit();
+
+            if (!CanRedo())
+            {
+                return false;
+            }
+
+            Step& step = m_Steps[m_Position++];
+            step.Target->Restore(step.After);
+
+            return true;
+        }
+
+        bool CanUndo() const
+        {
+            return m_Position > 0;
+        }
+
+        bool CanRedo() const
+        {
+            return m_Position < m_Steps.size();
+        }
+
+        /**
+         * @brief Drops every step that involves `layer`, for instance because it was deleted.
+         */
+        void Forget(const std::shared_ptr<Layer>& layer)
+        {
+            if (m_PendingLayer == layer)
+            {
+                m_PendingLayer = nullptr;
+                m_PendingSnapshot = LayerSnapshot();
+            }
+
+            for (size_t i = m_Steps.size(); i-- > 0;)
+            {
+                if (m_Steps[i].Target == layer)
+                {
+                    m_Steps.erase(m_Steps.begin() + i);
+
+                    if (i < m_Position)
+                    {
+                        m_Position--;
+                    }
+                }
+            }
+        }
+
+        void Clear()
+        {
+            m_Steps.clear();
+            m_Position = 0;
+
+            m_PendingLayer = nullptr;
+            m_PendingSnapshot = LayerSnapshot();
+        }
+
+        void SetMemoryLimit(size_t memoryLimit)
+        {
+            m_MemoryLimit = memoryLimit;
+            Trim();
+        }
+
+        size_t GetMemoryLimit() const
+        {
+            return m_MemoryLimit;
+        }
+
+        /**
+         * @brief Returns the bytes of pixel data held by the steps beyond what the layers already share.
+         */
+        size_t GetMemoryUsage() const
+        {
+            size_t usage = 0;
+
+            for (const auto& step : m_Steps)
+            {
+                usage += step.ByteSize;
+            }
+
+            return usage;
+        }
+
+    private:
+        /**
+         * @brief Drops the oldest steps until the memory usage fits the limit.
+         */
+        void Trim()
+        {
+            size_t usage = GetMemoryUsage();
+
+            while (m_Position > 0 && usage > m_MemoryLimit)
+            {
+                usage -= m_Steps.front().ByteSize;
+
+                m_Steps.pop_front();
+                m_Position--;
+            }
+        }
+    };
+}
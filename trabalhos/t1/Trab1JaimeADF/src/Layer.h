@@ -1,11 +1,23 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <memory>
-#include <queue>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "Vec2.h"
+#include "Rect.h"
 #include "Bitmap.h"
+#include "LayerSnapshot.h"
+#include "LayerSource.h"
+#include "Profiler.h"
 
 /**
  * @file Layer.h
@@ -17,6 +29,12 @@ namespace yap
     /**
      * @class Layer
      * @brief Represents a drawable layer that can manipulate a bitmap, including transformations, pixel operations, and visibility control.
+     *
+     * A layer may be created from a `LayerSource` instead of a bitmap, in which case its pixels are decoded
+     * the first time they are needed, either by `MakeResident` on a background thread or by any operation
+     * that touches them. Until then, the size and position of the layer are known, but it has no bitmap.
+     * If the source fails to decode, the layer keeps the error (see `GetLoadError`) and stands in with a
+     * transparent bitmap, which must not be saved in place of the original pixels.
      */
     class Layer
     {
@@ -26,14 +44,119 @@ namespace yap
         int m_X = 0;
         int m_Y = 0;
 
-        std::shared_ptr<Bitmap> m_Bitmap;
+        mutable std::shared_ptr<Bitmap> m_Bitmap;
+        mutable std::shared_ptr<const LayerSource> m_Source;
+
+        int m_SourceWidth = 0;
+        int m_SourceHeight = 0;
+
+        mutable std::mutex m_ResidencyMutex;
+        mutable std::atomic<bool> m_Resident;
+        mutable std::atomic<bool> m_Arrived;
+        mutable std::atomic<bool> m_Failed;
+        mutable std::string m_LoadError;
 
         bool m_Visible = true;
 
+        Rect m_Damage;
+        uint64_t m_Revision = 1;
+
     public:
         Layer(int id, const Bitmap& bitmap)
-            : m_Id(id), m_X(0), m_Y(0), m_Bitmap(std::make_shared<Bitmap>(bitmap))
+            : m_Id(id), m_X(0), m_Y(0), m_Bitmap(std::make_shared<Bitmap>(bitmap)), m_Resident(true), m_Arrived(false), m_Failed(false)
+        {
+        }
+
+        Layer(int id, Bitmap&& bitmap)
+            : m_Id(id), m_X(0), m_Y(0), m_Bitmap(std::make_shared<Bitmap>(std::move(bitmap))), m_Resident(true), m_Arrived(false), m_Failed(false)
+        {
+        }
+
+        Layer(int id, const std::shared_ptr<const LayerSource>& source)
+            : m_Id(id), m_X(0), m_Y(0), m_Source(source), m_SourceWidth(source->GetWidth()), m_SourceHeight(source->GetHeight()), m_Resident(false), m_Arrived(false), m_Failed(false)
+        {
+        }
+
+        bool IsResident() const
+        {
+            return m_Resident.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Decodes the pixels of the layer if they are not in memory yet. Safe to call from any thread;
+         * concurrent callers wait for the first one to finish.
+         *
+         * A source that fails to decode leaves the layer transparent, since the failure may surface on a
+         * thread that cannot report it; the error is kept and reported by `ConsumeLoadError`.
+         */
+        void MakeResident() const
+        {
+            if (IsResident())
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_ResidencyMutex);
+
+            if (m_Resident.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            ProfileScope scope("Layer::MakeResident");
+
+            bool failed = false;
+
+            try
+            {
+                m_Bitmap = std::make_shared<Bitmap>(m_Source->Decode());
+            }
+            catch (const std::exception& e)
+            {
+                m_Bitmap = std::make_shared<Bitmap>(m_SourceWidth, m_SourceHeight);
+                m_LoadError = *e.what() ? e.what() : "Unable to decode the layer";
+
+                failed = true;
+            }
+
+            m_Source.reset();
+
+            m_Arrived.store(true, std::memory_order_relaxed);
+            m_Resident.store(true, std::memory_order_release);
+
+            // Published after residency, so whoever sees the failure also sees the error.
+            m_Failed.store(failed, std::memory_order_release);
+        }
+
+        /**
+         * @brief Whether the source of the layer failed to decode, in which case its pixels are not the ones
+         * in the file it was loaded from.
+         */
+        bool HasLoadError() const
+        {
+            return IsResident() && !m_LoadError.empty();
+        }
+
+        /**
+         * @brief Returns why the source of the layer failed to decode, or an empty string.
+         */
+        std::string GetLoadError() const
+        {
+            return HasLoadError() ? m_LoadError : std::string();
+        }
+
+        /**
+         * @brief Returns the load error the first time it is called after the failure, and an empty string
+         * otherwise, so the thread that owns the project reports it once.
+         */
+        std::string ConsumeLoadError()
         {
+            if (!m_Failed.exchange(false))
+            {
+                return std::string();
+            }
+
+            return GetLoadError();
         }
 
         int GetId() const
@@ -43,17 +166,22 @@ namespace yap
 
         void SetPixel(int x, int y, const ColorRGBA& color)
         {
+            MakeResident();
+
             int bitmapX = x - m_X;
             int bitmapY = y - m_Y;
 
             if (bitmapX >= 0 && bitmapX < m_Bitmap->GetWidth() && bitmapY >= 0 && bitmapY < m_Bitmap->GetHeight())
             {
                 m_Bitmap->SetPixel(bitmapX, bitmapY, color);
+                Damage(Rect(x, y, 1, 1));
             }
         }
 
         ColorRGBA GetPixel(int x, int y) const
         {
+            MakeResident();
+
             int bitmapX = x - m_X;
             int bitmapY = y - m_Y;
 
@@ -67,8 +195,20 @@ namespace yap
 
         void SetPosition(const Vec2& position)
         {
-            m_X = position.X;
-            m_Y = position.Y;
+            int x = position.X;
+            int y = position.Y;
+
+            if (x == m_X && y == m_Y)
+            {
+                return;
+            }
+
+            Damage(GetBounds());
+
+            m_X = x;
+            m_Y = y;
+
+            Damage(GetBounds());
         }
 
         Vec2 GetPosition() const
@@ -78,61 +218,59 @@ namespace yap
 
         void FlipHorizontally()
         {
+            MakeResident();
+
             m_Bitmap->FlipHorizontally();
+            Damage(GetBounds());
         }
 
         void FlipVertically()
         {
+            MakeResident();
+
             m_Bitmap->FlipVertically();
+            Damage(GetBounds());
         }
 
-        void Fill(Vec2 position, const ColorRGBA& color)
+        /**
+         * @brief Flood fills the 4-connected region around `position` (in canvas coordinates) with `color`.
+         *
+         * A pixel belongs to the region when every channel differs from the clicked pixel by at most
+         * `tolerance`, in the `[0, 1]` range. Colors are sampled from the layer itself or, when `reference`
+         * is given, from that bitmap (typically the composited canvas, in canvas coordinates); only this
+         * layer is written.
+         *
+         * The fill works on horizontal spans: each seed is extended left and right along its row, the span
+         * is written at once and the runs of matching pixels right above and below it become new seeds.
+         * Rows are sampled once, the first time the fill reaches them.
+         */
+        void Fill(Vec2 position, const ColorRGBA& color, float tolerance = 0.0f, const Bitmap* reference = nullptr)
         {
-            int x = static_cast<int>(position.X);
-            int y = static_cast<int>(position.Y);
-
-            int width = m_Bitmap->GetWidth();
-            int height = m_Bitmap->GetHeight();
+            MakeResident();
 
-            ColorRGBA targetColor = GetPixel(x, y);
+            int startX = static_cast<int>(position.X) - m_X;
+            int startY = static_cast<int>(position.Y) - m_Y;
 
-            if (targetColor == color)
+            if (startX < 0 || startX >= m_Bitmap->GetWidth() || startY < 0 || startY >= m_Bitmap->GetHeight())
             {
                 return;
             }
 
-            std::queue<std::pair<int, int>> q;
-
-            SetPixel(x, y, color);
-            q.push({x, y});
-
-            int dx[4] = {-1, 1, 0, 0};
-            int dy[4] = {0, 0, -1, 1};
-
-            while (!q.empty()) {
-                auto c = q.front();
-                int cx = c.first;
-                int cy = c.second;
-
-                q.pop();
-
-                for (int i = 0; i < 4; ++i) {
-                    int nx = cx + dx[i];
-                    int ny = cy + dy[i];
-
-                    if (nx >= 0 && ny >= 0 && nx < width && ny < height) {
-                        if (GetPixel(nx, ny) == targetColor)
-                        {
-                            SetPixel(nx, ny, color);
-                            q.push({nx, ny});
-                        }
-                    }
-                }
+            // Work in the storage format of the layer, so spans are read and written without conversion.
+            if (m_Bitmap->GetFormat() == PixelFormat::RGBA8)
+            {
+                FillSpans<ColorRGBA8>(startX, startY, ColorRGBA8(color), tolerance, reference);
+            }
+            else
+            {
+                FillSpans<ColorRGBA>(startX, startY, color, tolerance, reference);
             }
         }
 
         void Rotate(float angle, const Vec2& pivot = Vec2())
         {
+            MakeResident();
+
             Vec2 size = GetSize();
             Vec2 position = GetPosition();
 
@@ -163,12 +301,16 @@ namespace yap
             Vec2 newSize = newBottomRight - newTopLeft;
             Vec2 newPosition = newTopLeft;
 
-            std::shared_ptr<Bitmap> output = std::make_shared<Bitmap>(static_cast<int>(newSize.X), static_cast<int>(newSize.Y));
+            std::shared_ptr<Bitmap> output = std::make_shared<Bitmap>(static_cast<int>(newSize.X), static_cast<int>(newSize.Y), m_Bitmap->GetFormat());
 
             Bitmap::Rotate(*m_Bitmap, *output, angle, pivot - position, position - newPosition);
 
+            Damage(GetBounds());
+
             m_Bitmap = output;
             SetPosition(newPosition);
+
+            Damage(GetBounds());
         }
 
         void Scale(const Vec2& newSize, ScalingMethod method = ScalingMethod::NearestNeighbor)
@@ -178,21 +320,38 @@ namespace yap
 
         void Scale(float newWidth, float newHeight, ScalingMethod method = ScalingMethod::NearestNeighbor)
         {
-            std::shared_ptr<Bitmap> output = std::make_shared<Bitmap>(static_cast<int>(newWidth), static_cast<int>(newHeight));
+            MakeResident();
+
+            std::shared_ptr<Bitmap> output = std::make_shared<Bitmap>(static_cast<int>(newWidth), static_cast<int>(newHeight), m_Bitmap->GetFormat());
 
             Bitmap::Scale(*m_Bitmap, *output, method);
 
+            Damage(GetBounds());
+
             m_Bitmap = output;
+
+            Damage(GetBounds());
         }
 
         Vec2 GetSize() const
         {
-            return Vec2(m_Bitmap->GetWidth(), m_Bitmap->GetHeight());
+            return Vec2(GetWidth(), GetHeight());
+        }
+
+        Rect GetBounds() const
+        {
+            return Rect(m_X, m_Y, GetWidth(), GetHeight());
         }
 
         void SetVisible(bool visible)
         {
+            if (visible == m_Visible)
+            {
+                return;
+            }
+
             m_Visible = visible;
+            Damage(GetBounds());
         }
 
         bool IsVisible() const
@@ -202,12 +361,246 @@ namespace yap
 
         void SetBitmap(const Bitmap& bitmap)
         {
-            m_Bitmap = std::make_shared<Bitmap>(bitmap);
+            Damage(GetBounds());
+
+            {
+                std::lock_guard<std::mutex> lock(m_ResidencyMutex);
+
+                m_Bitmap = std::make_shared<Bitmap>(bitmap);
+                m_Source.reset();
+
+                m_Resident.store(true, std::memory_order_release);
+            }
+
+            Damage(GetBounds());
         }
 
         std::shared_ptr<const Bitmap> GetBitmap() const
         {
+            MakeResident();
+
             return m_Bitmap;
         }
+
+        /**
+         * @brief Captures the pixels and position of the layer. The snapshot shares the tiles of the bitmap,
+         * so taking one is cheap and it only grows as the layer is modified afterwards.
+         */
+        LayerSnapshot TakeSnapshot() const
+        {
+            MakeResident();
+
+            return LayerSnapshot(*m_Bitmap, m_X, m_Y);
+        }
+
+        /**
+         * @brief Returns the layer to the state captured by `snapshot`, damaging only the tiles that differ
+         * when it stays in place.
+         */
+        void Restore(const LayerSnapshot& snapshot)
+        {
+            Rect difference = TakeSnapshot().GetDifference(snapshot);
+
+            if (m_X != snapshot.GetX() || m_Y != snapshot.GetY())
+            {
+                Damage(GetBounds());
+                Damage(Rect(snapshot.GetX(), snapshot.GetY(), snapshot.GetBitmap().GetWidth(), snapshot.GetBitmap().GetHeight()));
+            }
+            else
+            {
+                Damage(Rect(difference.X + m_X, difference.Y + m_Y, difference.Width, difference.Height));
+            }
+
+            *m_Bitmap = snapshot.GetBitmap();
+
+            m_X = snapshot.GetX();
+            m_Y = snapshot.GetY();
+        }
+
+        /**
+         * @brief Returns a number, never 0, that grows whenever the pixels, position, size or visibility of
+         * the layer change. Pixels decoded in the background count once they are reported by `ConsumeDamage`.
+         */
+        uint64_t GetRevision() const
+        {
+            return m_Revision;
+        }
+
+        /**
+         * @brief Returns the region of the canvas, in canvas coordinates, that changed since the last call
+         * and resets the accumulated damage.
+         */
+        Rect ConsumeDamage()
+        {
+            // Pixels decoded on another thread are reported here, on the thread that composites.
+            if (m_Arrived.exchange(false))
+            {
+                Damage(GetBounds());
+            }
+
+            Rect damage = m_Damage;
+            m_Damage = Rect();
+
+            return damage;
+        }
+
+    private:
+        int GetWidth() const
+        {
+            return IsResident() ? m_Bitmap->GetWidth() : m_SourceWidth;
+        }
+
+        int GetHeight() const
+        {
+            return IsResident() ? m_Bitmap->GetHeight() : m_SourceHeight;
+        }
+
+        template <typename Pixel>
+        void FillSpans(int startX, int startY, const Pixel& color, float tolerance, const Bitmap* reference)
+        {
+            int width = m_Bitmap->GetWidth();
+            int height = m_Bitmap->GetHeight();
+
+            std::vector<Pixel> samples(width);
+            std::vector<Pixel> fillRow(width, color);
+
+            // Pixels still to be filled, per row; a row is empty until the fill first reaches it.
+            std::vector<std::vector<uint8_t>> candidates(height);
+
+            auto sampleRow = [&](int y)
+            {
+                if (!reference)
+                {
+                    m_Bitmap->ReadSpan(0, y, width, samples.data());
+                    return;
+                }
+
+                std::fill(samples.begin(), samples.end(), Pixel(ColorRGBA(0, 0, 0, 0)));
+
+                int canvasY = y + m_Y;
+                int first = std::max(0, -m_X);
+                int last = std::min(width, reference->GetWidth() - m_X);
+
+                if (canvasY >= 0 && canvasY < reference->GetHeight() && first < last)
+                {
+                    reference->ReadSpan(first + m_X, canvasY, last - first, &samples[first]);
+                }
+            };
+
+            sampleRow(startY);
+
+            Pixel targetColor = samples[startX];
+
+            auto getCandidates = [&](int y) -> std::vector<uint8_t>&
+            {
+                std::vector<uint8_t>& row = candidates[y];
+
+                if (row.empty())
+                {
+                    if (y != startY)
+                    {
+                        sampleRow(y);
+                    }
+
+                    row.resize(width);
+
+                    for (int x = 0; x < width; ++x)
+                    {
+                        row[x] = IsWithinTolerance(samples[x], targetColor, tolerance) ? 1 : 0;
+                    }
+                }
+
+                return row;
+            };
+
+            Rect filled;
+
+            std::vector<std::pair<int, int>> seeds;
+            seeds.emplace_back(startX, startY);
+
+            while (!seeds.empty())
+            {
+                int seedX = seeds.back().first;
+                int y = seeds.back().second;
+
+                seeds.pop_back();
+
+                std::vector<uint8_t>& row = getCandidates(y);
+
+                if (!row[seedX])
+                {
+                    continue;
+                }
+
+                int left = seedX;
+                int right = seedX;
+
+                while (left > 0 && row[left - 1])
+                {
+                    left--;
+                }
+
+                while (right < width - 1 && row[right + 1])
+                {
+                    right++;
+                }
+
+                std::fill(row.begin() + left, row.begin() + right + 1, 0);
+                m_Bitmap->WriteSpan(left, y, right - left + 1, &fillRow[left]);
+
+                filled = Rect::Union(filled, Rect(left, y, right - left + 1, 1));
+
+                for (int neighborY = y - 1; neighborY <= y + 1; neighborY += 2)
+                {
+                    if (neighborY < 0 || neighborY >= height)
+                    {
+                        continue;
+                    }
+
+                    std::vector<uint8_t>& neighbor = getCandidates(neighborY);
+
+                    bool inRun = false;
+
+                    for (int x = left; x <= right; ++x)
+                    {
+                        if (neighbor[x] && !inRun)
+                        {
+                            seeds.emplace_back(x, neighborY);
+                        }
+
+                        inRun = neighbor[x] != 0;
+                    }
+                }
+            }
+
+            if (!filled.IsEmpty())
+            {
+                Damage(Rect(filled.X + m_X, filled.Y + m_Y, filled.Width, filled.Height));
+            }
+        }
+
+        static bool IsWithinTolerance(const ColorRGBA8& color, const ColorRGBA8& target, float tolerance)
+        {
+            int threshold = static_cast<int>(tolerance * 255.0f + 0.5f);
+
+            return std::abs(color.R - target.R) <= threshold &&
+                std::abs(color.G - target.G) <= threshold &&
+                std::abs(color.B - target.B) <= threshold &&
+                std::abs(color.A - target.A) <= threshold;
+        }
+
+        static bool IsWithinTolerance(const ColorRGBA& color, const ColorRGBA& target, float tolerance)
+        {
+            return std::fabs(color.R - target.R) <= tolerance &&
+                std::fabs(color.G - target.G) <= tolerance &&
+                std::fabs(color.B - target.B) <= tolerance &&
+                std::fabs(color.A - target.A) <= tolerance;
+        }
+
+        void Damage(const Rect& region)
+        {
+            m_Damage = Rect::Union(m_Damage, region);
+            m_Revision++;
+        }
     };
 }
\ No newline at end of file
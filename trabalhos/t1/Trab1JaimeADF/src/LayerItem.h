@@ -35,6 +35,8 @@ namespace yap
         std::shared_ptr<Box> m_Preview;
         std::shared_ptr<Text> m_Name;
 
+        uint64_t m_PreviewRevision = 0;
+
         std::shared_ptr<Box> m_Line;
 
     public:
@@ -134,6 +136,15 @@ namespace yap
             Box::Animate();
 
             m_Information->ToggleTrait("selected", m_Project->GetActiveLayer() == m_Layer);
+
+            // Layers loaded lazily show an empty preview until their pixels arrive.
+            if (!m_Layer->IsResident() || m_Layer->GetRevision() == m_PreviewRevision)
+            {
+                return;
+            }
+
+            m_PreviewRevision = m_Layer->GetRevision();
+
             m_Preview->SetStyle(
                 m_Preview->GetStyle()
                     .WithBackground(BoxBackground::Image(m_Layer->GetBitmap()))
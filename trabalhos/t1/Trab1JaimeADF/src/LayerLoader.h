@@ -0,0 +1,152 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "Layer.h"
+#include "Profiler.h"
+
+/**
+ * @file LayerLoader.h
+ * @brief Defines the LayerLoader class, which decodes lazily loaded layers in the background.
+ */
+
+namespace yap
+{
+    /**
+     * @class LayerLoader
+     * @brief Makes queued layers resident on a background thread, in the order they were requested.
+     *
+     * Like `EffectJob`, the loader owns its thread instead of using the shared pool, which may have no
+     * workers; decoding a layer still splits its chunks over the pool. A layer that arrives reports its
+     * whole bounds as damaged, so the next render picks it up.
+     *
+     * The queue does not keep layers alive: a layer deleted from the project before its turn is skipped
+     * instead of being decoded for nothing.
+     */
+    class LayerLoader
+    {
+    private:
+        std::thread m_Worker;
+
+        std::deque<std::weak_ptr<Layer>> m_Queue;
+
+        // Compared by owner, so a deleted layer that is still queued is never mistaken for a new layer
+        // allocated at the same address.
+        std::set<std::weak_ptr<Layer>, std::owner_less<std::weak_ptr<Layer>>> m_Queued;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+
+        bool m_Stopping = false;
+
+    public:
+        LayerLoader()
+        {
+            m_Worker = std::thread([this]() { RunWorker(); });
+        }
+
+        ~LayerLoader()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Stopping = true;
+            }
+
+            m_Condition.notify_all();
+            m_Worker.join();
+        }
+
+        LayerLoader(const LayerLoader&) = delete;
+        LayerLoader& operator=(const LayerLoader&) = delete;
+
+        /**
+         * @brief Queues a layer to be decoded. Layers that are resident or already queued are ignored.
+         */
+        void Enqueue(const std::shared_ptr<Layer>& layer)
+        {
+            if (layer->IsResident())
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+
+                if (!m_Queued.insert(layer).second)
+                {
+                    return;
+                }
+
+                m_Queue.push_back(layer);
+            }
+
+            m_Condition.notify_one();
+        }
+
+        /**
+         * @brief Whether any layer is queued or still decoding.
+         */
+        bool IsBusy()
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            return !m_Queued.empty();
+        }
+
+        /**
+         * @brief Drops the layers that have not started decoding yet.
+         */
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            m_Queue.clear();
+            m_Queued.clear();
+        }
+
+    private:
+        void RunWorker()
+        {
+            Profiler::Get().SetThreadName("Layer loader");
+
+            while (true)
+            {
+                std::weak_ptr<Layer> entry;
+                std::shared_ptr<Layer> layer;
+
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    m_Condition.wait(lock, [this]() { return m_Stopping || !m_Queue.empty(); });
+
+                    if (m_Stopping)
+                    {
+                        return;
+                    }
+
+                    entry = m_Queue.front();
+                    m_Queue.pop_front();
+
+                    layer = entry.lock();
+
+                    if (!layer)
+                    {
+                        m_Queued.erase(entry);
+                        continue;
+                    }
+                }
+
+                layer->MakeResident();
+
+                {
+                    std::lock_guard<std::mutex> lock(m_Mutex);
+                    m_Queued.erase(entry);
+                }
+            }
+        }
+    };
+}
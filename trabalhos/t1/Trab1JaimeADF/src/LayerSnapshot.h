@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Bitmap.h"
+#include "Rect.h"
+
+/**
+ * @file LayerSnapshot.h
+ * @brief Defines the LayerSnapshot class, an immutable copy of the pixels and position of a layer that
+ * shares its tiles with the layer and with other snapshots.
+ */
+
+namespace yap
+{
+    /**
+     * @class LayerSnapshot
+     * @brief Captures a layer as a copy of its bitmap.
+     *
+     * Copying a `Bitmap` only copies pointers to its tiles, and the layer copies a tile the first time it
+     * writes to it afterwards, so a snapshot costs nothing until the layer changes, and then only the
+     * tiles that changed. Two snapshots of the same layer differ exactly where their tiles are not shared,
+     * which lets `GetDifference` and `GetByteSizeExcluding` look at tile pointers instead of pixels.
+     */
+    class LayerSnapshot
+    {
+    private:
+        int m_X = 0;
+        int m_Y = 0;
+
+        Bitmap m_Bitmap;
+
+    public:
+        LayerSnapshot()
+        {
+        }
+
+        LayerSnapshot(const Bitmap& bitmap, int x, int y)
+            : m_X(x), m_Y(y), m_Bitmap(bitmap)
+        {
+        }
+
+        /**
+         * @brief Returns the bounding box, in bitmap coordinates, of the tiles that differ between both
+         * snapshots; the whole bitmap when their sizes or formats differ.
+         */
+        Rect GetDifference(const LayerSnapshot& other) const
+        {
+            if (!HasSameLayout(other))
+            {
+                return Rect::Union(
+                    Rect(0, 0, m_Bitmap.GetWidth(), m_Bitmap.GetHeight()),
+                    Rect(0, 0, other.m_Bitmap.GetWidth(), other.m_Bitmap.GetHeight())
+                );
+            }
+
+            Rect difference;
+
+            for (int row = 0; row < m_Bitmap.GetTileRowCount(); ++row)
+            {
+                for (int column = 0; column < m_Bitmap.GetTileColumnCount(); ++column)
+                {
+                    if (!m_Bitmap.SharesTile(other.m_Bitmap, column, row))
+                    {
+                        difference = Rect::Union(difference, m_Bitmap.GetTileBounds(column, row));
+                    }
+                }
+            }
+
+            return difference;
+        }
+
+        /**
+         * @brief Returns the memory taken by the stored tiles of this snapshot that `other` does not share.
+         */
+        size_t GetByteSizeExcluding(const LayerSnapshot& other) const
+        {
+            bool sameLayout = HasSameLayout(other);
+
+            size_t size = 0;
+
+            for (int row = 0; row < m_Bitmap.GetTileRowCount(); ++row)
+            {
+                for (int column = 0; column < m_Bitmap.GetTileColumnCount(); ++column)
+                {
+                    if (!m_Bitmap.IsTileEmpty(column, row) && (!sameLayout || !m_Bitmap.SharesTile(other.m_Bitmap, column, row)))
+                    {
+                        size += m_Bitmap.GetTileByteSize();
+                    }
+                }
+            }
+
+            return size;
+        }
+
+        /**
+         * @brief Whether both snapshots hold the same tiles at the same position.
+         */
+        bool IsSameAs(const LayerSnapshot& other) const
+        {
+            return m_X == other.m_X && m_Y == other.m_Y && HasSameLayout(other) && GetDifference(other).IsEmpty();
+        }
+
+        const Bitmap& GetBitmap() const
+        {
+            return m_Bitmap;
+        }
+
+        int GetX() const
+        {
+            return m_X;
+        }
+
+        int GetY() const
+        {
+            return m_Y;
+        }
+
+    private:
+        bool HasSameLayout(const LayerSnapshot& other) const
+        {
+            return m_Bitmap.GetWidth() == other.m_Bitmap.GetWidth() &&
+                m_Bitmap.GetHeight() == other.m_Bitmap.GetHeight() &&
+                m_Bitmap.GetFormat() == other.m_Bitmap.GetFormat();
+        }
+    };
+}
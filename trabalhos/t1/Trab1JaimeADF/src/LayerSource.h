@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Bitmap.h"
+
+/**
+ * @file LayerSource.h
+ * @brief Defines the LayerSource interface, which provides the pixels of a layer that is not resident yet.
+ */
+
+namespace yap
+{
+    /**
+     * @class LayerSource
+     * @brief Produces the bitmap of a layer on demand.
+     *
+     * The size must be known without decoding, so the layer can be laid out, listed and composited around
+     * before its pixels are available. `Decode` may be called from any thread.
+     */
+    class LayerSource
+    {
+    public:
+        virtual ~LayerSource() = default;
+
+        virtual int GetWidth() const = 0;
+        virtual int GetHeight() const = 0;
+
+        virtual Bitmap Decode() const = 0;
+    };
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file MappedFile.h
+ * @brief Defines the MappedFile class, a read-only memory mapping of a whole file.
+ */
+
+namespace yap
+{
+    /**
+     * @class MappedFile
+     * @brief Maps a file into memory for reading, so its contents are paged in only when touched.
+     */
+    class MappedFile
+    {
+    private:
+        const uint8_t* m_Data = nullptr;
+        size_t m_Size = 0;
+
+#ifdef _WIN32
+        HANDLE m_File = INVALID_HANDLE_VALUE;
+        HANDLE m_Mapping = NULL;
+#endif
+
+    public:
+        explicit MappedFile(const std::string& path)
+        {
+#ifdef _WIN32
+            m_File = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+            if (m_File == INVALID_HANDLE_VALUE)
+            {
+                throw std::runtime_error("Unable to open file for reading");
+            }
+
+            LARGE_INTEGER size;
+
+            if (!GetFileSizeEx(m_File, &size))
+            {
+                CloseHandle(m_File);
+                throw std::runtime_error("Unable to read file size");
+            }
+
+            m_Size = static_cast<size_t>(size.QuadPart);
+
+            if (m_Size == 0)
+            {
+                return;
+            }
+
+            m_Mapping = CreateFileMappingA(m_File, NULL, PAGE_READONLY, 0, 0, NULL);
+
+            if (m_Mapping != NULL)
+            {
+                m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+            }
+
+            if (m_Data == nullptr)
+            {
+                if (m_Mapping != NULL)
+                {
+                    CloseHandle(m_Mapping);
+                }
+
+                CloseHandle(m_File);
+                throw std::runtime_error("Unable to map file into memory");
+            }
+#else
+            int descriptor = open(path.c_str(), O_RDONLY);
+
+            if (descriptor < 0)
+            {
+                throw std::runtime_error("Unable to open file for reading");
+            }
+
+            struct stat status;
+
+            if (fstat(descriptor, &status) != 0)
+            {
+                close(descriptor);
+                throw std::runtime_error("Unable to read file size");
+            }
+
+            m_Size = static_cast<size_t>(status.st_size);
+
+            if (m_Size > 0)
+            {
+                void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+                if (data == MAP_FAILED)
+                {
+                    close(descriptor);
+                    throw std::runtime_error("Unable to map file into memory");
+                }
+
+                m_Data = static_cast<const uint8_t*>(data);
+            }
+
+            // The mapping stays valid after the descriptor is closed.
+            close(descriptor);
+#endif
+        }
+
+        ~MappedFile()
+        {
+#ifdef _WIN32
+            if (m_Data)
+            {
+                UnmapViewOfFile(m_Data);
+                CloseHandle(m_Mapping);
+            }
+
+            CloseHandle(m_File);
+#else
+            if (m_Data)
+            {
+                munmap(const_cast<uint8_t*>(m_Data), m_Size);
+            }
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const uint8_t* GetData() const
+        {
+            return m_Data;
+        }
+
+        size_t GetSize() const
+        {
+            return m_Size;
+        }
+    };
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "Benchmark.h"
+#include "Box.h"
+#include "Screen.h"
+#include "Text.h"
+
+/**
+ * @file PerformanceOverlay.h
+ * @brief Defines the PerformanceOverlay class, which shows the frame time statistics of the screen.
+ */
+
+namespace yap
+{
+    /**
+     * @class PerformanceOverlay
+     * @brief Shows the frame rate and the percentiles of the recent frame times.
+     *
+     * The first line describes the rolling window of the frame benchmark, so a stutter shows up in the p99
+     * and max for as long as it is in the window; the second line breaks the p99 down into recording and
+     * executing the draw commands and shows the slowest frame since startup. The text is refreshed a few
+     * times per second so it stays readable, and once more after activity stops so it shows the final stats.
+     */
+    class PerformanceOverlay : public Box
+    {
+    private:
+        static constexpr double RefreshInterval = 0.5;
+
+        std::shared_ptr<Text> m_FrameText;
+        std::shared_ptr<Text> m_BreakdownText;
+
+        std::chrono::steady_clock::time_point m_LastRefresh;
+        int32_t m_SettledFrames = -1;
+
+    public:
+        PerformanceOverlay()
+            : m_FrameText(std::make_shared<Text>()), m_BreakdownText(std::make_shared<Text>())
+        {
+            SetStyle(
+                StyleSheet()
+                    .WithSize(AxisSizingRule::Fit(), AxisSizingRule::Fit())
+                    .WithDirection(BoxDirection::Column)
+                    .WithGap(4)
+                    .WithForeground(ColorRGB(160, 160, 160))
+            );
+
+            AddChild(m_FrameText);
+            AddChild(m_BreakdownText);
+        }
+
+        void Animate() override
+        {
+            Box::Animate();
+
+            const std::shared_ptr<Screen>& screen = GetScreen();
+
+            // Every frame adds a render sample, so this tells whether frames other than the ones caused by
+            // the last refresh were rendered since; if not, the text already shows the current stats.
+            int32_t renderedFrames = screen->GetRenderBenchmark().GetSamples();
+
+            if (renderedFrames <= m_SettledFrames)
+            {
+                return;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            double elapsed = std::chrono::duration<double>(now - m_LastRefresh).count();
+
+            // Frames are only rendered on demand, so the refresh that shows the end of a burst of activity
+            // has to ask for its own frame.
+            if (elapsed < RefreshInterval)
+            {
+                screen->RequestFrameAfter(RefreshInterval - elapsed);
+                return;
+            }
+
+            m_LastRefresh = now;
+
+            const Benchmark& frame = screen->GetFrameBenchmark();
+            const Benchmark& render = screen->GetRenderBenchmark();
+            const Benchmark& execute = screen->GetExecuteBenchmark();
+
+            double average = frame.GetWindowAverageTime();
+
+            std::string frameText = Format(
+                "%.0f FPS  quadro p50 %.1f  p90 %.1f  p99 %.1f  max %.1f ms",
+                average > 0.0 ? 1.0 / average : 0.0,
+                frame.GetWindowPercentile(50.0) * 1000.0,
+                frame.GetWindowPercentile(90.0) * 1000.0,
+                frame.GetWindowPercentile(99.0) * 1000.0,
+                frame.GetWindowMaxTime() * 1000.0
+            );
+
+            std::string breakdownText = Format(
+                "p99 interface %.1f  comandos %.1f ms  pior quadro %.1f ms",
+                render.GetWindowPercentile(99.0) * 1000.0,
+                execute.GetWindowPercentile(99.0) * 1000.0,
+                frame.GetMaxTime() * 1000.0
+            );
+
+            // The frame that refreshes the text, and the one that settles after it if the text changed.
+            m_SettledFrames = renderedFrames + (frameText != m_FrameText->Content || breakdownText != m_BreakdownText->Content ? 2 : 1);
+
+            m_FrameText->Content = frameText;
+            m_BreakdownText->Content = breakdownText;
+        }
+
+    private:
+        template <typename... Args>
+        static std::string Format(const char* format, Args... args)
+        {
+            char buffer[128];
+            std::snprintf(buffer, sizeof(buffer), format, args...);
+
+            return buffer;
+        }
+    };
+}
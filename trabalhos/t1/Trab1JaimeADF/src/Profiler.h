@@ -0,0 +1,338 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @file Profiler.h
+ * @brief Defines the Profiler class, which records timed zones of every thread into ring buffers and exports
+ * them as a Chrome trace, and the ProfileScope class, which times a zone for as long as it is alive.
+ */
+
+namespace yap
+{
+    /**
+     * @struct ProfileEvent
+     * @brief A finished zone, with times in nanoseconds since the profiler was created.
+     */
+    struct ProfileEvent
+    {
+        const char* Name;
+
+        int64_t Start;
+        int64_t Duration;
+    };
+
+    /**
+     * @class Profiler
+     * @brief Collects the zones timed by `ProfileScope` while a capture is running.
+     *
+     * Every thread writes to a ring buffer of its own, created the first time it records a zone, so
+     * recording takes no lock: the owner fills a slot and then publishes it by advancing the head. When the
+     * ring is full the oldest zones are overwritten, which keeps the latest `RingCapacity` zones of each
+     * thread. Exporting copies the published zones and drops any that the owner overwrote meanwhile.
+     *
+     * Zones nest naturally: an inner scope finishes, and is recorded, before the outer one, and the trace
+     * viewer stacks zones of the same thread by their times.
+     *
+     * Zone names are stored as pointers and must outlive the capture; use string literals.
+     */
+    class Profiler
+    {
+    public:
+        static const size_t RingCapacity = 16384;
+
+    private:
+        struct ThreadBuffer
+        {
+            int Id = 0;
+            std::string Name;
+
+            std::vector<ProfileEvent> Events;
+            std::atomic<uint64_t> Head;
+
+            // Zones before this index belong to an earlier capture. Only touched under the profiler mutex.
+            uint64_t Tail = 0;
+
+            std::atomic<bool> Exited;
+
+            ThreadBuffer() : Events(RingCapacity), Head(0), Exited(false)
+            {
+            }
+        };
+
+        /**
+         * Per-thread state; flags the buffer when the thread exits so the next capture can release it.
+         */
+        struct ThreadState
+        {
+            std::string Name;
+            std::shared_ptr<ThreadBuffer> Buffer;
+
+            ~ThreadState()
+            {
+                if (Buffer)
+                {
+                    Buffer->Exited = true;
+                }
+            }
+        };
+
+        std::atomic<bool> m_Enabled;
+
+        std::chrono::steady_clock::time_point m_Epoch;
+
+        std::vector<std::shared_ptr<ThreadBuffer>> m_Buffers;
+        int m_NextThreadId = 1;
+
+        std::mutex m_Mutex;
+
+    public:
+        Profiler() : m_Enabled(false), m_Epoch(std::chrono::steady_clock::now())
+        {
+        }
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        /**
+         * @brief Drops the zones recorded so far and starts recording new ones.
+         */
+        void Start()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+
+                m_Buffers.erase(
+                    std::remove_if(m_Buffers.begin(), m_Buffers.end(), [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                        return buffer->Exited.load();
+                    }),
+                    m_Buffers.end()
+                );
+
+                for (const auto& buffer : m_Buffers)
+                {
+                    buffer->Tail = buffer->Head.load(std::memory_order_acquire);
+                }
+            }
+
+            m_Enabled = true;
+        }
+
+        void Stop()
+        {
+            m_Enabled = false;
+        }
+
+        bool IsEnabled() const
+        {
+            return m_Enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the nanoseconds elapsed since the profiler was created.
+         */
+        int64_t Now() const
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Epoch).count();
+        }
+
+        /**
+         * @brief Names the calling thread in exported traces.
+         */
+        void SetThreadName(const std::string& name)
+        {
+            ThreadState& state = GetThreadState();
+            state.Name = name;
+
+            if (state.Buffer)
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                state.Buffer->Name = name;
+            }
+        }
+
+        /**
+         * @brief Records a finished zone of the calling thread.
+         */
+        void Record(const char* name, int64_t start, int64_t end)
+        {
+            ThreadBuffer& buffer = GetThreadBuffer();
+
+            uint64_t head = buffer.Head.load(std::memory_order_relaxed);
+
+            ProfileEvent& event = buffer.Events[head % RingCapacity];
+            event.Name = name;
+            event.Start = start;
+            event.Duration = end - start;
+
+            buffer.Head.store(head + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Writes the zones of the current capture as a Chrome trace-event JSON file, which can be
+         * opened in chrome://tracing or Perfetto.
+         */
+        void ExportChromeTrace(const std::string& path)
+        {
+            std::FILE* file = std::fopen(path.c_str(), "w");
+
+            if (!file)
+            {
+                throw std::runtime_error("Unable to open trace file for writing");
+            }
+
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+            bool first = true;
+
+            for (const auto& buffer : m_Buffers)
+            {
+                std::string name = buffer->Name.empty() ? "Thread " + std::to_string(buffer->Id) : buffer->Name;
+
+                std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n", buffer->Id, Escape(name).c_str());
+                first = false;
+
+                for (const auto& event : CopyEvents(*buffer))
+                {
+                    std::fprintf(
+                        file,
+                        ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                        Escape(event.Name).c_str(),
+                        buffer->Id,
+                        event.Start / 1000.0,
+                        event.Duration / 1000.0
+                    );
+                }
+            }
+
+            std::fprintf(file, "\n]}\n");
+            std::fclose(file);
+        }
+
+        /**
+         * @brief Returns the profiler shared by the whole application.
+         */
+        static Profiler& Get()
+        {
+            static Profiler profiler;
+            return profiler;
+        }
+
+    private:
+        static ThreadState& GetThreadState()
+        {
+            static thread_local ThreadState state;
+            return state;
+        }
+
+        ThreadBuffer& GetThreadBuffer()
+        {
+            ThreadState& state = GetThreadState();
+
+            if (!state.Buffer)
+            {
+                auto buffer = std::make_shared<ThreadBuffer>();
+
+                std::lock_guard<std::mutex> lock(m_Mutex);
+
+                buffer->Id = m_NextThreadId++;
+                buffer->Name = state.Name;
+
+                m_Buffers.push_back(buffer);
+                state.Buffer = buffer;
+            }
+
+            return *state.Buffer;
+        }
+
+        std::vector<ProfileEvent> CopyEvents(const ThreadBuffer& buffer) const
+        {
+            uint64_t head = buffer.Head.load(std::memory_order_acquire);
+            uint64_t first = std::max(buffer.Tail, head > RingCapacity ? head - RingCapacity : 0);
+
+            std::vector<ProfileEvent> events;
+            events.reserve(head - first);
+
+            for (uint64_t i = first; i < head; ++i)
+            {
+                events.push_back(buffer.Events[i % RingCapacity]);
+            }
+
+            // The owner may have lapped the ring while we copied; those slots hold newer zones now. It also
+            // writes slot `latestHead` before publishing it, so the event that shares that slot may be torn.
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            uint64_t latestHead = buffer.Head.load(std::memory_order_relaxed);
+            uint64_t firstValid = latestHead + 1 > RingCapacity ? latestHead + 1 - RingCapacity : 0;
+
+            if (firstValid > first)
+            {
+                events.erase(events.begin(), events.begin() + std::min<uint64_t>(firstValid - first, events.size()));
+            }
+
+            return events;
+        }
+
+        static std::string Escape(const std::string& text)
+        {
+            std::string escaped;
+
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    escaped += '\\';
+                }
+
+                escaped += c;
+            }
+
+            return escaped;
+        }
+    };
+
+    /**
+     * @class ProfileScope
+     * @brief Times the enclosing block as a zone named `name`, if a capture is running when it starts.
+     */
+    class ProfileScope
+    {
+    private:
+        const char* m_Name;
+
+        int64_t m_Start = 0;
+        bool m_Active;
+
+    public:
+        explicit ProfileScope(const char* name) : m_Name(name), m_Active(Profiler::Get().IsEnabled())
+        {
+            if (m_Active)
+            {
+                m_Start = Profiler::Get().Now();
+            }
+        }
+
+        ~ProfileScope()
+        {
+            if (m_Active)
+            {
+                Profiler& profiler = Profiler::Get();
+                profiler.Record(m_Name, m_Start, profiler.Now());
+            }
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+    };
+}
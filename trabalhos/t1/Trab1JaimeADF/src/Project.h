@@ -1,6 +1,12 @@
 #pragma once
 
+#include "Composite.h"
+#include "History.h"
 #include "Layer.h"
+#include "LayerLoader.h"
+#include "Profiler.h"
+#include "ProjectFile.h"
+#include "ThreadPool.h"
 
 /**
  * @file Project.h
@@ -29,13 +35,21 @@ namespace yap
 
         std::shared_ptr<Bitmap> m_CanvasBitmap;
 
+        Rect m_DirtyRect;
+
+        LayerLoader m_Loader;
+
+        History m_History;
+
     public:
         std::function<void(Project&, std::shared_ptr<Layer>)> OnLayerCreated = nullptr;
         std::function<void(Project&, std::shared_ptr<Layer>)> OnLayerDeleted = nullptr;
         std::function<void(Project&, std::shared_ptr<Layer>)> OnLayerMoved = nullptr;
         std::function<void(Project&, std::shared_ptr<Layer>)> OnLayerSelected = nullptr;
+        std::function<void(Project&, std::shared_ptr<Layer>, const std::string&)> OnLayerLoadFailed = nullptr;
         
-        Project(int width, int height) : m_CanvasBitmap(std::make_shared<Bitmap>(width, height))
+        Project(int width, int height)
+            : m_CanvasBitmap(std::make_shared<Bitmap>(width, height)), m_DirtyRect(0, 0, width, height)
         {
         }
 
@@ -44,29 +58,119 @@ namespace yap
             return m_CanvasBitmap;
         }
 
-        std::shared_ptr<const Bitmap> RenderCanvas()
+        /**
+         * @brief Returns the undo history. Tools wrap their changes to a layer in `Begin` and `Commit`.
+         */
+        History& GetHistory()
+        {
+            return m_History;
+        }
+
+        /**
+         * @brief Composites the visible layers into the canvas bitmap.
+         *
+         * Only the region damaged since the previous call is recomposited; when nothing changed the
+         * cached canvas is returned untouched. The region is split into tiles that are composited in
+         * parallel on the shared thread pool.
+         *
+         * By default, visible layers whose pixels are not resident yet are left out and queued for decoding;
+         * they are composited on the first render after they arrive, which suits the progressive composite on
+         * screen. Anything that needs the complete image (exports, sampling) passes `waitForLayers`, which
+         * decodes them first. Layers whose pixels failed to decode since the last render are reported through
+         * `OnLayerLoadFailed`.
+         */
+        std::shared_ptr<const Bitmap> RenderCanvas(bool waitForLayers = false)
         {
-            for (int x = 0; x < m_CanvasBitmap->GetWidth(); ++x)
+            ProfileScope scope("Project::RenderCanvas");
+
+            for (const auto& layer : m_Layers)
             {
-                for (int y = 0; y < m_CanvasBitmap->GetHeight(); ++y)
+                // Decoded before the damage is taken, so layers left out of earlier renders are recomposited now.
+                if (waitForLayers && layer->IsVisible())
                 {
-                    ColorRGBA canvasColor = ColorRGBA(0.0f, 0.0f, 0.0f, 0.0f);
+                    layer->MakeResident();
+                }
 
-                    for (const auto& layer : m_Layers)
-                    {
-                        if (layer->IsVisible())
-                        {
-                            canvasColor = layer->GetPixel(x, y).CompositeOver(canvasColor);
-                        }
-                    }
+                m_DirtyRect = Rect::Union(m_DirtyRect, layer->ConsumeDamage());
+
+                std::string error = layer->ConsumeLoadError();
+
+                if (!error.empty() && OnLayerLoadFailed)
+                {
+                    OnLayerLoadFailed(*this, layer, error);
+                }
+            }
+
+            Rect region = Rect::Intersect(m_DirtyRect, Rect(0, 0, m_CanvasBitmap->GetWidth(), m_CanvasBitmap->GetHeight()));
+            m_DirtyRect = Rect();
+
+            if (region.IsEmpty())
+            {
+                return m_CanvasBitmap;
+            }
 
-                    m_CanvasBitmap->SetPixel(x, y, canvasColor);
+            // Whoever displays the canvas has seen everything up to here, so only this composite is new.
+            m_CanvasBitmap->ResetDirtyRect();
+
+            std::vector<CompositeSource> sources;
+
+            for (const auto& layer : m_Layers)
+            {
+                Rect bounds = layer->GetBounds();
+
+                if (!layer->IsVisible() || !bounds.Intersects(region))
+                {
+                    continue;
                 }
+
+                if (!layer->IsResident())
+                {
+                    m_Loader.Enqueue(layer);
+                    continue;
+                }
+
+                sources.push_back({ layer->GetBitmap(), bounds });
             }
 
+            // Tiles follow the grid of the canvas bitmap, so no two threads write to the same bitmap tile.
+            int firstColumn = region.GetLeft() / CompositeTileSize;
+            int firstRow = region.GetTop() / CompositeTileSize;
+            int columns = (region.GetRight() - 1) / CompositeTileSize - firstColumn + 1;
+            int rows = (region.GetBottom() - 1) / CompositeTileSize - firstRow + 1;
+
+            ThreadPool::GetShared().ParallelFor(columns * rows, [&](int index) {
+                int tileX = (firstColumn + index % columns) * CompositeTileSize;
+                int tileY = (firstRow + index / columns) * CompositeTileSize;
+
+                Rect tile = Rect::Intersect(region, Rect(tileX, tileY, CompositeTileSize, CompositeTileSize));
+
+                CompositeTile(sources, tile);
+            });
+
             return m_CanvasBitmap;
         }
 
+        /**
+         * @brief Marks a region of the canvas, in canvas coordinates, to be recomposited on the next render.
+         */
+        void Invalidate(const Rect& region)
+        {
+            m_DirtyRect = Rect::Union(m_DirtyRect, region);
+        }
+
+        void Invalidate()
+        {
+            Invalidate(Rect(0, 0, m_CanvasBitmap->GetWidth(), m_CanvasBitmap->GetHeight()));
+        }
+
+        /**
+         * @brief Whether layers are still being loaded in the background.
+         */
+        bool IsLoading()
+        {
+            return m_Loader.IsBusy();
+        }
+
         void SetActiveLayer(std::shared_ptr<Layer> layer)
         {
             m_ActiveLayer = layer;
@@ -135,6 +239,8 @@ namespace yap
                 }
 
                 m_Layers.erase(it);
+                m_History.Forget(layer);
+                Invalidate(layer->GetBounds());
 
                 if (OnLayerDeleted)
                 {
@@ -150,6 +256,7 @@ namespace yap
             if (it != m_Layers.end() && it + 1 != m_Layers.end())
             {
                 std::iter_swap(it, it + 1);
+                Invalidate(Rect::Union((*it)->GetBounds(), (*(it + 1))->GetBounds()));
 
                 if (OnLayerMoved)
                 {
@@ -162,9 +269,10 @@ namespace yap
         {
             auto it = std::find(m_Layers.begin(), m_Layers.end(), layer);
 
-            if (it != m_Layers.begin())
+            if (it != m_Layers.end() && it != m_Layers.begin())
             {
                 std::iter_swap(it, it - 1);
+                Invalidate(Rect::Union((*it)->GetBounds(), (*(it - 1))->GetBounds()));
 
                 if (OnLayerMoved)
                 {
@@ -173,63 +281,57 @@ namespace yap
             }
         }
 
+        /**
+         * @brief Saves the project in the version 2 format. Layers that are still backed by a file are decoded
+         * first, which releases the file so it can be overwritten.
+         *
+         * Fails without writing anything if a layer could not be decoded, since saving would replace its
+         * pixels in the file with the transparent ones that stand in for them.
+         */
         void Save(const std::string& path)
         {
-            std::ofstream file(path, std::ios::binary);
-
-            if (!file)
-            {
-                throw std::runtime_error("Unable to open file for writing");
-            }
+            ProjectFileHeader header;
 
-            uint32_t type = 0x4410;
+            header.NextLayerId = m_NextLayerId;
+            header.ActiveLayerId = m_ActiveLayer ? m_ActiveLayer->GetId() : -1;
+            header.CanvasWidth = m_CanvasBitmap->GetWidth();
+            header.CanvasHeight = m_CanvasBitmap->GetHeight();
 
-            int32_t nextLayerId = m_NextLayerId;
-            int32_t activeLayerId = m_ActiveLayer ? m_ActiveLayer->GetId() : -1;
-            int32_t canvasWidth = m_CanvasBitmap->GetWidth();
-            int32_t canvasHeight = m_CanvasBitmap->GetHeight();
-            int32_t layerCount = static_cast<int32_t>(m_Layers.size());
-
-            file.write(reinterpret_cast<const char*>(&type), sizeof(type));
-            file.write(reinterpret_cast<const char*>(&nextLayerId), sizeof(nextLayerId));
-            file.write(reinterpret_cast<const char*>(&activeLayerId), sizeof(activeLayerId));
-            file.write(reinterpret_cast<const char*>(&canvasWidth), sizeof(canvasWidth));
-            file.write(reinterpret_cast<const char*>(&canvasHeight), sizeof(canvasHeight));
-            file.write(reinterpret_cast<const char*>(&layerCount), sizeof(layerCount));
+            std::vector<ProjectFileLayer> records;
+            std::vector<std::shared_ptr<const Bitmap>> bitmaps;
 
             for (const auto& layer : m_Layers)
             {
-                int32_t layerId = layer->GetId();
-
                 std::shared_ptr<const Bitmap> layerBitmap = layer->GetBitmap();
 
-                Vec2 layerPosition = layer->GetPosition();
-                Vec2 layerSize = layer->GetSize();
-
-                bool layerVisibility = layer->IsVisible();
+                if (layer->HasLoadError())
+                {
+                    throw std::runtime_error("Layer " + std::to_string(layer->GetId()) + " failed to load (" + layer->GetLoadError() + "), so saving would lose its pixels");
+                }
 
-                file.write(reinterpret_cast<const char*>(&layerId), sizeof(layerId));
-                file.write(reinterpret_cast<const char*>(&layerPosition.X), sizeof(layerPosition.X));
-                file.write(reinterpret_cast<const char*>(&layerPosition.Y), sizeof(layerPosition.Y));
-                file.write(reinterpret_cast<const char*>(&layerSize.X), sizeof(layerSize.X));
-                file.write(reinterpret_cast<const char*>(&layerSize.Y), sizeof(layerSize.Y));
-                file.write(reinterpret_cast<const char*>(&layerVisibility), sizeof(layerVisibility));
+                ProjectFileLayer record;
 
-                for (int y = 0; y < layerBitmap->GetHeight(); ++y)
-                {
-                    for (int x = 0; x < layerBitmap->GetWidth(); ++x)
-                    {
-                        ColorRGBA pixel = layerBitmap->GetPixel(x, y);
+                record.Id = layer->GetId();
+                record.X = static_cast<int32_t>(layer->GetPosition().X);
+                record.Y = static_cast<int32_t>(layer->GetPosition().Y);
+                record.Width = layerBitmap->GetWidth();
+                record.Height = layerBitmap->GetHeight();
+                record.Visible = layer->IsVisible();
+                record.Depth = ProjectFile::GetDepth(*layerBitmap);
 
-                        file.write(reinterpret_cast<const char*>(&pixel.R), sizeof(pixel.R));
-                        file.write(reinterpret_cast<const char*>(&pixel.G), sizeof(pixel.G));
-                        file.write(reinterpret_cast<const char*>(&pixel.B), sizeof(pixel.B));
-                        file.write(reinterpret_cast<const char*>(&pixel.A), sizeof(pixel.A));
-                    }
-                }
+                records.push_back(record);
+                bitmaps.push_back(layerBitmap);
             }
+
+            ProjectFile::Save(path, header, records, bitmaps);
         }
 
+        /**
+         * @brief Loads a project, accepting both the chunked version 2 format and the raw version 1 format.
+         *
+         * Version 2 files are memory-mapped and only their directory is read here; the pixels of each layer
+         * are decoded in the background, or whenever the layer is first used.
+         */
         void Load(const std::string& path)
         {
             std::ifstream file(path, std::ios::binary);
@@ -239,6 +341,89 @@ namespace yap
                 throw std::runtime_error("Unable to open file for reading");
             }
 
+            uint32_t type = 0;
+
+            file.read(reinterpret_cast<char*>(&type), sizeof(type));
+            file.seekg(0);
+
+            if (type == ProjectFile::Signature)
+            {
+                LoadChunked(file, path);
+            }
+            else if (type == ProjectFile::LegacySignature)
+            {
+                LoadLegacy(file);
+            }
+            else
+            {
+                throw std::runtime_error("Invalid YAP file format");
+            }
+        }
+
+        const std::vector<std::shared_ptr<Layer>> GetLayers() const
+        {
+            return m_Layers;
+        }
+
+        void SetSize(int width, int height)
+        {
+            m_CanvasBitmap->Reallocate(width, height);
+            Invalidate();
+        }
+
+        int GetWidth() const
+        {
+            return m_CanvasBitmap->GetWidth();
+        }
+
+        int GetHeight() const
+        {
+            return m_CanvasBitmap->GetHeight();
+        }
+    
+    private:
+        static const int CompositeTileSize = Bitmap::TileSize;
+
+        void LoadChunked(std::ifstream& file, const std::string& path)
+        {
+            ProjectFileHeader header;
+            std::vector<ProjectFileLayer> records;
+
+            ProjectFile::ReadDirectory(file, header, records);
+
+            auto mappedFile = std::make_shared<const MappedFile>(path);
+
+            std::vector<std::shared_ptr<Layer>> layers;
+            layers.reserve(records.size());
+
+            for (const auto& record : records)
+            {
+                auto layer = std::make_shared<Layer>(record.Id, std::make_shared<MappedLayerSource>(mappedFile, record));
+                layer->SetPosition(Vec2(record.X, record.Y));
+                layer->SetVisible(record.Visible);
+
+                layers.push_back(layer);
+            }
+
+            ReplaceLayers(header.CanvasWidth, header.CanvasHeight, header.NextLayerId, header.ActiveLayerId, layers);
+
+            // Visible layers are needed for the first frame; hidden ones only for their previews.
+            for (const auto& layer : layers)
+            {
+                if (layer->IsVisible())
+                {
+                    m_Loader.Enqueue(layer);
+                }
+            }
+
+            for (const auto& layer : layers)
+            {
+                m_Loader.Enqueue(layer);
+            }
+        }
+
+        void LoadLegacy(std::ifstream& file)
+        {
             uint32_t type = 0;
             int32_t nextLayerId = 0;
             int32_t activeLayerId = 0;
@@ -248,7 +433,7 @@ namespace yap
 
             file.read(reinterpret_cast<char*>(&type), sizeof(type));
 
-            if (type != 0x4410)
+            if (type != ProjectFile::LegacySignature)
             {
                 throw std::runtime_error("Invalid YAP file format");
             }
@@ -276,20 +461,19 @@ namespace yap
                 file.read(reinterpret_cast<char*>(&layerSize.Y), sizeof(layerSize.Y));
                 file.read(reinterpret_cast<char*>(&layerVisibility), sizeof(layerVisibility));
 
-                Bitmap bitmap(static_cast<int>(layerSize.X), static_cast<int>(layerSize.Y));
+                Bitmap bitmap(static_cast<int>(layerSize.X), static_cast<int>(layerSize.Y), PixelFormat::RGBAF32);
+
+                // Version 1 stores each pixel as four consecutive floats, the same layout as ColorRGBA.
+                std::vector<ColorRGBA> row(bitmap.GetWidth());
 
                 for (int y = 0; y < bitmap.GetHeight(); ++y)
                 {
-                    for (int x = 0; x < bitmap.GetWidth(); ++x)
+                    if (!file.read(reinterpret_cast<char*>(row.data()), row.size() * sizeof(ColorRGBA)))
                     {
-                        ColorRGBA pixel;
-                        file.read(reinterpret_cast<char*>(&pixel.R), sizeof(pixel.R));
-                        file.read(reinterpret_cast<char*>(&pixel.G), sizeof(pixel.G));
-                        file.read(reinterpret_cast<char*>(&pixel.B), sizeof(pixel.B));
-                        file.read(reinterpret_cast<char*>(&pixel.A), sizeof(pixel.A));
-
-                        bitmap.SetPixel(x, y, pixel);
+                        throw std::runtime_error("Unexpected end of YAP file");
                     }
+
+                    bitmap.WriteSpan(0, y, bitmap.GetWidth(), row.data());
                 }
 
                 auto layer = std::make_shared<Layer>(layerId, bitmap);
@@ -299,48 +483,88 @@ namespace yap
                 layers.push_back(layer);
             }
 
+            ReplaceLayers(canvasWidth, canvasHeight, nextLayerId, activeLayerId, layers);
+        }
+
+        void ReplaceLayers(int canvasWidth, int canvasHeight, int nextLayerId, int activeLayerId, const std::vector<std::shared_ptr<Layer>>& layers)
+        {
             while (m_Layers.size() > 0)
             {
                 DeleteLayer(m_Layers.back());
             }
 
+            m_Loader.Clear();
+            m_History.Clear();
+
             SetSize(canvasWidth, canvasHeight);
 
             m_NextLayerId = nextLayerId;
-            m_ActiveLayer = *std::find_if(layers.begin(), layers.end(), [activeLayerId](const std::shared_ptr<Layer>& layer) {
+
+            auto activeLayer = std::find_if(layers.begin(), layers.end(), [activeLayerId](const std::shared_ptr<Layer>& layer) {
                 return layer->GetId() == activeLayerId;
             });
 
+            m_ActiveLayer = activeLayer != layers.end() ? *activeLayer : nullptr;
+
             for (const auto& layer : layers)
             {
                 RegisterLayer(layer);
             }
         }
 
-        const std::vector<std::shared_ptr<Layer>> GetLayers() const
+        struct CompositeSource
         {
-            return m_Layers;
-        }
+            std::shared_ptr<const Bitmap> Image;
+            Rect Bounds;
+        };
 
-        void SetSize(int width, int height)
+        void CompositeTile(const std::vector<CompositeSource>& sources, const Rect& tile)
         {
-            m_CanvasBitmap->Reallocate(width, height);
-        }
+            ProfileScope scope("Project::CompositeTile");
 
-        int GetWidth() const
-        {
-            return m_CanvasBitmap->GetWidth();
-        }
+            ColorRGBA canvasRow[CompositeTileSize];
+            ColorRGBA layerRow[CompositeTileSize];
 
-        int GetHeight() const
-        {
-            return m_CanvasBitmap->GetHeight();
+            // Layers whose tiles under this one are all empty contribute nothing and are skipped.
+            std::vector<const CompositeSource*> tileSources;
+            tileSources.reserve(sources.size());
+
+            for (const auto& source : sources)
+            {
+                Rect overlap = Rect::Intersect(source.Bounds, tile);
+
+                if (!source.Image->IsRegionEmpty(Rect(overlap.X - source.Bounds.X, overlap.Y - source.Bounds.Y, overlap.Width, overlap.Height)))
+                {
+                    tileSources.push_back(&source);
+                }
+            }
+
+            for (int y = tile.GetTop(); y < tile.GetBottom(); ++y)
+            {
+                std::fill(canvasRow, canvasRow + tile.Width, ColorRGBA(0.0f, 0.0f, 0.0f, 0.0f));
+
+                for (const CompositeSource* source : tileSources)
+                {
+                    Rect span = Rect::Intersect(source->Bounds, Rect(tile.X, y, tile.Width, 1));
+
+                    if (span.IsEmpty())
+                    {
+                        continue;
+                    }
+
+                    source->Image->ReadSpan(span.X - source->Bounds.X, y - source->Bounds.Y, span.Width, layerRow);
+
+                    Composite::SourceOver(layerRow, canvasRow + (span.X - tile.X), span.Width);
+                }
+
+                m_CanvasBitmap->WriteSpan(tile.X, y, tile.Width, canvasRow);
+            }
         }
-    
-    private:
+
         void RegisterLayer(std::shared_ptr<Layer> layer)
         {
             m_Layers.push_back(layer);
+            Invalidate(layer->GetBounds());
 
             if (OnLayerCreated)
             {
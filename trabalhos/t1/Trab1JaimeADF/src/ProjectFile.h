@@ -0,0 +1,598 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Bitmap.h"
+#include "Compression.h"
+#include "LayerSource.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+
+/**
+ * @file ProjectFile.h
+ * @brief Reads and writes version 2 of the `.yap` project format.
+ *
+ * A file starts with a fixed header, followed by a directory with one record per layer and, for every
+ * layer, a table of chunks. The pixel data follows the directory. Each chunk holds a band of up to
+ * `ChunkRows` rows, quantized to 8 or 16 bits per channel, filtered by subtracting the previous pixel
+ * from each pixel and compressed with `LZ`. Chunks carry a CRC-32 of their compressed bytes, and the
+ * header carries one of the directory. All values are little-endian.
+ *
+ * Version 1 files (signature 0x4410, raw floats) are still read by `Project::Load`.
+ */
+
+namespace yap
+{
+    /**
+     * @struct ProjectFileHeader
+     * @brief Project-wide values stored in the file header.
+     */
+    struct ProjectFileHeader
+    {
+        int32_t NextLayerId = 0;
+        int32_t ActiveLayerId = -1;
+        int32_t CanvasWidth = 0;
+        int32_t CanvasHeight = 0;
+    };
+
+    /**
+     * @struct ProjectFileChunk
+     * @brief Location and checksum of a compressed band of rows.
+     */
+    struct ProjectFileChunk
+    {
+        uint64_t Offset = 0;
+        uint32_t Size = 0;
+        uint32_t Checksum = 0;
+    };
+
+    /**
+     * @struct ProjectFileLayer
+     * @brief Directory record of a layer.
+     */
+    struct ProjectFileLayer
+    {
+        int32_t Id = 0;
+        int32_t X = 0;
+        int32_t Y = 0;
+        int32_t Width = 0;
+        int32_t Height = 0;
+        bool Visible = true;
+
+        /**
+         * @brief Bits per channel of the stored pixels, either 8 or 16.
+         */
+        int Depth = 8;
+        int ChunkRows = 0;
+
+        std::vector<ProjectFileChunk> Chunks;
+    };
+
+    /**
+     * @class ProjectFile
+     * @brief Encodes and decodes the chunks of a version 2 project file.
+     */
+    class ProjectFile
+    {
+    public:
+        static const uint32_t Signature = 0x32504159; // "YAP2"
+        static const uint32_t LegacySignature = 0x4410;
+
+        static const uint16_t Version = 2;
+
+        /**
+         * @brief Rows per chunk in the files written here. A multiple of the bitmap tile size, so chunks
+         * cover whole rows of tiles and can be decoded into the same bitmap in parallel.
+         */
+        static const int ChunkRows = 64;
+
+        static_assert(ChunkRows % Bitmap::TileSize == 0, "Chunks must cover whole rows of bitmap tiles");
+
+        /**
+         * @brief Writes a project. `layers[i]` describes `bitmaps[i]`; its chunk table is filled in here.
+         *
+         * Chunks are compressed in parallel, a few batches at a time, so memory use is bounded by the batch
+         * rather than by the size of the layers.
+         */
+        static void Save(const std::string& path, const ProjectFileHeader& header, std::vector<ProjectFileLayer> layers, const std::vector<std::shared_ptr<const Bitmap>>& bitmaps)
+        {
+            std::ofstream file(path, std::ios::binary);
+
+            if (!file)
+            {
+                throw std::runtime_error("Unable to open file for writing");
+            }
+
+            size_t directorySize = 0;
+
+            for (auto& layer : layers)
+            {
+                layer.ChunkRows = ChunkRows;
+                layer.Chunks.assign(GetChunkCount(layer), ProjectFileChunk());
+
+                directorySize += LayerRecordSize + layer.Chunks.size() * ChunkRecordSize;
+            }
+
+            // The directory is written last, once the chunk offsets are known.
+            std::vector<uint8_t> placeholder(HeaderSize + directorySize);
+            file.write(reinterpret_cast<const char*>(placeholder.data()), placeholder.size());
+
+            uint64_t offset = placeholder.size();
+
+            ThreadPool& pool = ThreadPool::GetShared();
+
+            int batchSize = static_cast<int>(std::max<size_t>(4, 2 * (pool.GetThreadCount() + 1)));
+
+            std::vector<std::vector<uint8_t>> compressed(batchSize);
+
+            for (size_t i = 0; i < layers.size(); ++i)
+            {
+                ProjectFileLayer& layer = layers[i];
+                const Bitmap& bitmap = *bitmaps[i];
+
+                int chunkCount = static_cast<int>(layer.Chunks.size());
+
+                for (int first = 0; first < chunkCount; first += batchSize)
+                {
+                    int count = std::min(batchSize, chunkCount - first);
+
+                    pool.ParallelFor(count, [&](int index) {
+                        EncodeChunk(layer, bitmap, first + index, compressed[index]);
+                    });
+
+                    for (int index = 0; index < count; ++index)
+                    {
+                        ProjectFileChunk& chunk = layer.Chunks[first + index];
+
+                        chunk.Offset = offset;
+                        chunk.Size = static_cast<uint32_t>(compressed[index].size());
+                        chunk.Checksum = CRC32::Compute(compressed[index].data(), compressed[index].size());
+
+                        file.write(reinterpret_cast<const char*>(compressed[index].data()), compressed[index].size());
+
+                        offset += chunk.Size;
+                    }
+                }
+            }
+
+            std::vector<uint8_t> data(HeaderSize + directorySize);
+            uint8_t* directory = data.data() + HeaderSize;
+
+            size_t position = 0;
+
+            for (const auto& layer : layers)
+            {
+                WriteLittleEndian<int32_t>(directory, position + 0, layer.Id);
+                WriteLittleEndian<int32_t>(directory, position + 4, layer.X);
+                WriteLittleEndian<int32_t>(directory, position + 8, layer.Y);
+                WriteLittleEndian<int32_t>(directory, position + 12, layer.Width);
+                WriteLittleEndian<int32_t>(directory, position + 16, layer.Height);
+                WriteLittleEndian<uint8_t>(directory, position + 20, layer.Visible ? 1 : 0);
+                WriteLittleEndian<uint8_t>(directory, position + 21, layer.Depth);
+                WriteLittleEndian<int32_t>(directory, position + 24, layer.ChunkRows);
+                WriteLittleEndian<uint32_t>(directory, position + 28, static_cast<uint32_t>(layer.Chunks.size()));
+
+                position += LayerRecordSize;
+
+                for (const auto& chunk : layer.Chunks)
+                {
+                    WriteLittleEndian<uint64_t>(directory, position + 0, chunk.Offset);
+                    WriteLittleEndian<uint32_t>(directory, position + 8, chunk.Size);
+                    WriteLittleEndian<uint32_t>(directory, position + 12, chunk.Checksum);
+
+                    position += ChunkRecordSize;
+                }
+            }
+
+            WriteLittleEndian<uint32_t>(data.data(), 0, Signature);
+            WriteLittleEndian<uint16_t>(data.data(), 4, Version);
+            WriteLittleEndian<int32_t>(data.data(), 8, header.NextLayerId);
+            WriteLittleEndian<int32_t>(data.data(), 12, header.ActiveLayerId);
+            WriteLittleEndian<int32_t>(data.data(), 16, header.CanvasWidth);
+            WriteLittleEndian<int32_t>(data.data(), 20, header.CanvasHeight);
+            WriteLittleEndian<int32_t>(data.data(), 24, static_cast<int32_t>(layers.size()));
+            WriteLittleEndian<uint32_t>(data.data(), 28, CRC32::Compute(directory, directorySize));
+
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+            if (!file)
+            {
+                throw std::runtime_error("Unable to write project file");
+            }
+        }
+
+        /**
+         * @brief Reads the header and directory of a version 2 file, leaving the stream at the first chunk.
+         */
+        static void ReadDirectory(std::istream& file, ProjectFileHeader& header, std::vector<ProjectFileLayer>& layers)
+        {
+            uint8_t headerData[HeaderSize];
+
+            if (!file.read(reinterpret_cast<char*>(headerData), HeaderSize))
+            {
+                throw std::runtime_error("Invalid YAP file format");
+            }
+
+            if (ReadLittleEndian<uint32_t>(headerData, 0) != Signature)
+            {
+                throw std::runtime_error("Invalid YAP file format");
+            }
+
+            if (ReadLittleEndian<uint16_t>(headerData, 4) > Version)
+            {
+                throw std::runtime_error("Unsupported YAP file version");
+            }
+
+            header.NextLayerId = ReadLittleEndian<int32_t>(headerData, 8);
+            header.ActiveLayerId = ReadLittleEndian<int32_t>(headerData, 12);
+            header.CanvasWidth = ReadLittleEndian<int32_t>(headerData, 16);
+            header.CanvasHeight = ReadLittleEndian<int32_t>(headerData, 20);
+
+            int32_t layerCount = ReadLittleEndian<int32_t>(headerData, 24);
+            uint32_t directoryChecksum = ReadLittleEndian<uint32_t>(headerData, 28);
+
+            if (header.CanvasWidth < 0 || header.CanvasHeight < 0 || layerCount < 0)
+            {
+                throw std::runtime_error("Invalid YAP file format");
+            }
+
+            uint32_t checksum = 0;
+
+            layers.clear();
+            layers.reserve(layerCount);
+
+            for (int32_t i = 0; i < layerCount; ++i)
+            {
+                uint8_t record[LayerRecordSize];
+
+                if (!file.read(reinterpret_cast<char*>(record), LayerRecordSize))
+                {
+                    throw std::runtime_error("Unexpected end of YAP file");
+                }
+
+                checksum = CRC32::Compute(record, LayerRecordSize, checksum);
+
+                ProjectFileLayer layer;
+
+                layer.Id = ReadLittleEndian<int32_t>(record, 0);
+                layer.X = ReadLittleEndian<int32_t>(record, 4);
+                layer.Y = ReadLittleEndian<int32_t>(record, 8);
+                layer.Width = ReadLittleEndian<int32_t>(record, 12);
+                layer.Height = ReadLittleEndian<int32_t>(record, 16);
+                layer.Visible = ReadLittleEndian<uint8_t>(record, 20) != 0;
+                layer.Depth = ReadLittleEndian<uint8_t>(record, 21);
+                layer.ChunkRows = ReadLittleEndian<int32_t>(record, 24);
+
+                uint32_t chunkCount = ReadLittleEndian<uint32_t>(record, 28);
+
+                if (layer.Width < 0 || layer.Height < 0 || layer.ChunkRows <= 0 || (layer.Depth != 8 && layer.Depth != 16))
+                {
+                    throw std::runtime_error("Invalid YAP layer record");
+                }
+
+                if (chunkCount != GetChunkCount(layer))
+                {
+                    throw std::runtime_error("Invalid YAP layer record");
+                }
+
+                std::vector<uint8_t> table(static_cast<size_t>(chunkCount) * ChunkRecordSize);
+
+                if (!file.read(reinterpret_cast<char*>(table.data()), table.size()))
+                {
+                    throw std::runtime_error("Unexpected end of YAP file");
+                }
+
+                checksum = CRC32::Compute(table.data(), table.size(), checksum);
+
+                layer.Chunks.resize(chunkCount);
+
+                for (uint32_t c = 0; c < chunkCount; ++c)
+                {
+                    layer.Chunks[c].Offset = ReadLittleEndian<uint64_t>(table.data(), c * ChunkRecordSize + 0);
+                    layer.Chunks[c].Size = ReadLittleEndian<uint32_t>(table.data(), c * ChunkRecordSize + 8);
+                    layer.Chunks[c].Checksum = ReadLittleEndian<uint32_t>(table.data(), c * ChunkRecordSize + 12);
+                }
+
+                layers.push_back(layer);
+            }
+
+            if (checksum != directoryChecksum)
+            {
+                throw std::runtime_error("YAP file directory is corrupted");
+            }
+        }
+
+        /**
+         * @brief Calls `body(i)` for `i` in `[0, count)`, in parallel when the chunks of `layer` cover whole
+         * rows of bitmap tiles. Files written elsewhere may use any chunk height, in which case two chunks
+         * could share a tile, so they are decoded one after the other.
+         */
+        template <typename Function>
+        static void ForEachChunk(const ProjectFileLayer& layer, int count, Function body)
+        {
+            if (layer.ChunkRows % Bitmap::TileSize == 0)
+            {
+                ThreadPool::GetShared().ParallelFor(count, body);
+                return;
+            }
+
+            for (int index = 0; index < count; ++index)
+            {
+                body(index);
+            }
+        }
+
+        /**
+         * @brief Verifies, decompresses and stores one chunk into the matching rows of `bitmap`.
+         */
+        static void DecodeChunk(const ProjectFileLayer& layer, int chunkIndex, const uint8_t* data, size_t size, Bitmap& bitmap)
+        {
+            if (CRC32::Compute(data, size) != layer.Chunks[chunkIndex].Checksum)
+            {
+                throw std::runtime_error("YAP file chunk is corrupted");
+            }
+
+            int firstRow = chunkIndex * layer.ChunkRows;
+            int rowCount = std::min(layer.ChunkRows, layer.Height - firstRow);
+
+            size_t pixelSize = GetPixelSize(layer);
+            size_t rowSize = pixelSize * layer.Width;
+
+            std::vector<uint8_t> bytes(rowSize * rowCount);
+
+            LZ::Decompress(data, size, bytes.data(), bytes.size());
+
+            std::vector<ColorRGBA8> pixels8;
+            std::vector<ColorRGBA> pixelsF32;
+
+            for (int row = 0; row < rowCount; ++row)
+            {
+                uint8_t* rowBytes = bytes.data() + row * rowSize;
+
+                for (size_t i = pixelSize; i < rowSize; ++i)
+                {
+                    rowBytes[i] += rowBytes[i - pixelSize];
+                }
+
+                if (layer.Depth == 8)
+                {
+                    pixels8.resize(layer.Width);
+
+                    for (int x = 0; x < layer.Width; ++x)
+                    {
+                        const uint8_t* pixel = rowBytes + x * pixelSize;
+                        pixels8[x] = ColorRGBA8(pixel[0], pixel[1], pixel[2], pixel[3]);
+                    }
+
+                    bitmap.WriteSpan(0, firstRow + row, layer.Width, pixels8.data());
+                }
+                else
+                {
+                    pixelsF32.resize(layer.Width);
+
+                    for (int x = 0; x < layer.Width; ++x)
+                    {
+                        const uint8_t* pixel = rowBytes + x * pixelSize;
+
+                        pixelsF32[x] = ColorRGBA(
+                            ReadLittleEndian<uint16_t>(pixel, 0) / 65535.0f,
+                            ReadLittleEndian<uint16_t>(pixel, 2) / 65535.0f,
+                            ReadLittleEndian<uint16_t>(pixel, 4) / 65535.0f,
+                            ReadLittleEndian<uint16_t>(pixel, 6) / 65535.0f
+                        );
+                    }
+
+                    bitmap.WriteSpan(0, firstRow + row, layer.Width, pixelsF32.data());
+                }
+            }
+        }
+
+        /**
+         * @brief Returns the depth used to store a bitmap without losing precision.
+         *
+         * RGBA8 bitmaps use 8 bits. Float bitmaps use 16 bits, unless every channel already holds an 8-bit
+         * value, which is the case for layers imported from BMP files or from version 1 projects.
+         */
+        static int GetDepth(const Bitmap& bitmap)
+        {
+            if (bitmap.GetFormat() == PixelFormat::RGBA8)
+            {
+                return 8;
+            }
+
+            ColorRGBA row[Bitmap::TileSize];
+
+            // Empty tiles hold zeros, which 8 bits represent exactly.
+            for (int tileRow = 0; tileRow < bitmap.GetTileRowCount(); ++tileRow)
+            {
+                for (int tileColumn = 0; tileColumn < bitmap.GetTileColumnCount(); ++tileColumn)
+                {
+                    if (bitmap.IsTileEmpty(tileColumn, tileRow))
+                    {
+                        continue;
+                    }
+
+                    Rect tile = bitmap.GetTileBounds(tileColumn, tileRow);
+
+                    for (int y = tile.GetTop(); y < tile.GetBottom(); ++y)
+                    {
+                        bitmap.ReadSpan(tile.X, y, tile.Width, row);
+
+                        for (int x = 0; x < tile.Width; ++x)
+                        {
+                            ColorRGBA quantized = ColorRGBA8(row[x]).ToRGBA();
+
+                            if (quantized.R != row[x].R || quantized.G != row[x].G || quantized.B != row[x].B || quantized.A != row[x].A)
+                            {
+                                return 16;
+                            }
+                        }
+                    }
+                }
+            }
+
+            return 8;
+        }
+
+        static PixelFormat GetPixelFormat(const ProjectFileLayer& layer)
+        {
+            return layer.Depth == 8 ? PixelFormat::RGBA8 : PixelFormat::RGBAF32;
+        }
+
+    private:
+        static const size_t HeaderSize = 32;
+        static const size_t LayerRecordSize = 32;
+        static const size_t ChunkRecordSize = 16;
+
+        static uint32_t GetChunkCount(const ProjectFileLayer& layer)
+        {
+            return static_cast<uint32_t>((static_cast<int64_t>(layer.Height) + layer.ChunkRows - 1) / layer.ChunkRows);
+        }
+
+        static size_t GetPixelSize(const ProjectFileLayer& layer)
+        {
+            return layer.Depth == 8 ? 4 : 8;
+        }
+
+        static void EncodeChunk(const ProjectFileLayer& layer, const Bitmap& bitmap, int chunkIndex, std::vector<uint8_t>& compressed)
+        {
+            int firstRow = chunkIndex * layer.ChunkRows;
+            int rowCount = std::min(layer.ChunkRows, layer.Height - firstRow);
+
+            size_t pixelSize = GetPixelSize(layer);
+            size_t rowSize = pixelSize * layer.Width;
+
+            std::vector<uint8_t> bytes(rowSize * rowCount);
+
+            std::vector<ColorRGBA8> pixels8;
+            std::vector<ColorRGBA> pixelsF32;
+
+            for (int row = 0; row < rowCount; ++row)
+            {
+                uint8_t* rowBytes = bytes.data() + row * rowSize;
+
+                if (layer.Depth == 8)
+                {
+                    pixels8.resize(layer.Width);
+                    bitmap.ReadSpan(0, firstRow + row, layer.Width, pixels8.data());
+
+                    for (int x = 0; x < layer.Width; ++x)
+                    {
+                        uint8_t* pixel = rowBytes + x * pixelSize;
+
+                        pixel[0] = pixels8[x].R;
+                        pixel[1] = pixels8[x].G;
+                        pixel[2] = pixels8[x].B;
+                        pixel[3] = pixels8[x].A;
+                    }
+                }
+                else
+                {
+                    pixelsF32.resize(layer.Width);
+                    bitmap.ReadSpan(0, firstRow + row, layer.Width, pixelsF32.data());
+
+                    for (int x = 0; x < layer.Width; ++x)
+                    {
+                        uint8_t* pixel = rowBytes + x * pixelSize;
+
+                        WriteLittleEndian<uint16_t>(pixel, 0, Quantize16(pixelsF32[x].R));
+                        WriteLittleEndian<uint16_t>(pixel, 2, Quantize16(pixelsF32[x].G));
+                        WriteLittleEndian<uint16_t>(pixel, 4, Quantize16(pixelsF32[x].B));
+                        WriteLittleEndian<uint16_t>(pixel, 6, Quantize16(pixelsF32[x].A));
+                    }
+                }
+
+                for (size_t i = rowSize; i-- > pixelSize;)
+                {
+                    rowBytes[i] -= rowBytes[i - pixelSize];
+                }
+            }
+
+            LZ::Compress(bytes.data(), bytes.size(), compressed);
+        }
+
+        static uint16_t Quantize16(float value)
+        {
+            return static_cast<uint16_t>(Clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+        }
+
+        template <typename T>
+        static T ReadLittleEndian(const uint8_t* data, size_t offset)
+        {
+            uint64_t value = 0;
+
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                value |= static_cast<uint64_t>(data[offset + i]) << (8 * i);
+            }
+
+            return static_cast<T>(value);
+        }
+
+        template <typename T>
+        static void WriteLittleEndian(uint8_t* data, size_t offset, T value)
+        {
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                data[offset + i] = static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i));
+            }
+        }
+    };
+
+    /**
+     * @class MappedLayerSource
+     * @brief Decodes a layer straight from the chunks of a memory-mapped project file.
+     *
+     * Only the chunks of the layer are paged in, and only when it is decoded, so a project can be opened
+     * without reading the pixels of any of its layers.
+     */
+    class MappedLayerSource : public LayerSource
+    {
+    private:
+        std::shared_ptr<const MappedFile> m_File;
+        ProjectFileLayer m_Layer;
+
+    public:
+        MappedLayerSource(const std::shared_ptr<const MappedFile>& file, const ProjectFileLayer& layer)
+            : m_File(file), m_Layer(layer)
+        {
+            for (const auto& chunk : m_Layer.Chunks)
+            {
+                if (chunk.Offset > m_File->GetSize() || chunk.Size > m_File->GetSize() - chunk.Offset)
+                {
+                    throw std::runtime_error("Unexpected end of YAP file");
+                }
+            }
+        }
+
+        int GetWidth() const override
+        {
+            return m_Layer.Width;
+        }
+
+        int GetHeight() const override
+        {
+            return m_Layer.Height;
+        }
+
+        Bitmap Decode() const override
+        {
+            Bitmap bitmap(m_Layer.Width, m_Layer.Height, ProjectFile::GetPixelFormat(m_Layer));
+
+            ProjectFile::ForEachChunk(m_Layer, static_cast<int>(m_Layer.Chunks.size()), [&](int index) {
+                const ProjectFileChunk& chunk = m_Layer.Chunks[index];
+
+                ProjectFile::DecodeChunk(m_Layer, index, m_File->GetData() + chunk.Offset, chunk.Size, bitmap);
+            });
+
+            return bitmap;
+        }
+    };
+}
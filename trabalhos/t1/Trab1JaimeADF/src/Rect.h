@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+
+/**
+ * @file Rect.h
+ * @brief Defines the Rect struct, an integer axis-aligned rectangle used to describe regions of pixels.
+ */
+
+namespace yap
+{
+    /**
+     * @struct Rect
+     * @brief Represents an axis-aligned rectangle with integer coordinates.
+     *
+     * A rectangle with a non-positive width or height is considered empty. Empty rectangles
+     * act as the identity element for `Union` and absorb everything in `Intersect`.
+     */
+    struct Rect
+    {
+        int X, Y;
+        int Width, Height;
+
+        Rect() : X(0), Y(0), Width(0), Height(0) {}
+        Rect(int x, int y, int width, int height) : X(x), Y(y), Width(width), Height(height) {}
+
+        int GetLeft() const
+        {
+            return X;
+        }
+
+        int GetTop() const
+        {
+            return Y;
+        }
+
+        int GetRight() const
+        {
+            return X + Width;
+        }
+
+        int GetBottom() const
+        {
+            return Y + Height;
+        }
+
+        bool IsEmpty() const
+        {
+            return Width <= 0 || Height <= 0;
+        }
+
+        bool Contains(int x, int y) const
+        {
+            return x >= X && x < X + Width && y >= Y && y < Y + Height;
+        }
+
+        bool Intersects(const Rect& other) const
+        {
+            return !Intersect(*this, other).IsEmpty();
+        }
+
+        bool operator==(const Rect& other) const
+        {
+            return X == other.X && Y == other.Y && Width == other.Width && Height == other.Height;
+        }
+
+        bool operator!=(const Rect& other) const
+        {
+            return !(*this == other);
+        }
+
+        static Rect Union(const Rect& a, const Rect& b)
+        {
+            if (a.IsEmpty())
+            {
+                return b;
+            }
+
+            if (b.IsEmpty())
+            {
+                return a;
+            }
+
+            int left = std::min(a.X, b.X);
+            int top = std::min(a.Y, b.Y);
+            int right = std::max(a.GetRight(), b.GetRight());
+            int bottom = std::max(a.GetBottom(), b.GetBottom());
+
+            return Rect(left, top, right - left, bottom - top);
+        }
+
+        static Rect Intersect(const Rect& a, const Rect& b)
+        {
+            int left = std::max(a.X, b.X);
+            int top = std::max(a.Y, b.Y);
+            int right = std::min(a.GetRight(), b.GetRight());
+            int bottom = std::min(a.GetBottom(), b.GetBottom());
+
+            if (right <= left || bottom <= top)
+            {
+                return Rect();
+            }
+
+            return Rect(left, top, right - left, bottom - top);
+        }
+    };
+}
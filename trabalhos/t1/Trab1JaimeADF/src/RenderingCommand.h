@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 
 #include "Color.h"
@@ -9,7 +11,8 @@
  * @brief Defines structures and classes for rendering commands used in a graphics rendering pipeline.
  * 
  * This file contains argument structures for various rendering commands, an enumeration for command types,
- * and the `RenderingCommand` class, which encapsulates a rendering command and its associated arguments.
+ * the `RenderingCommand` class, which reads a command packed in a `RenderingCommandBuffer`, and the
+ * `RenderingCommandList` range over such commands.
  */
 
 namespace yap
@@ -88,6 +91,8 @@ namespace yap
 
     /**
      * @brief Arguments for rendering text.
+     *
+     * The characters are copied into the command buffer, so `Text` only needs to live until it is recorded.
      */
     struct TextRenderingCommandArguments
     {
@@ -96,6 +101,21 @@ namespace yap
         const char* Text;
     };
 
+    /**
+     * @brief Arguments for rendering an image.
+     *
+     * `Pixels` points to `Width * Height` tightly packed RGBA8 pixels stored top to bottom. The data is
+     * not copied, so it must stay alive until the command is executed.
+     */
+    struct ImageRenderingCommandArguments
+    {
+        float X;
+        float Y;
+        int Width;
+        int Height;
+        const unsigned char* Pixels;
+    };
+
     /**
      * @brief Enumeration of rendering command types.
      */
@@ -109,95 +129,171 @@ namespace yap
         Vertex,
         StrokePolygon,
         FillPolygon,
-        Text
+        Text,
+        Image
     };
 
     /**
-     * @brief Represents a rendering command with associated arguments.
+     * @brief A view over one rendering command stored in a `RenderingCommandBuffer`.
+     *
+     * Commands are variable-length records packed one after the other: a 4-byte header with the kind in
+     * the low byte and the size of the whole record in the upper 24 bits, followed by the arguments and
+     * padding up to a multiple of `Alignment`. Commands without arguments are only the header, and text
+     * commands store their position followed by the characters and a terminator, so the text lives in the
+     * buffer. Records are only aligned to 4 bytes, so arguments are copied out when accessed.
      */
     class RenderingCommand
     {
+    public:
+        static const size_t Alignment = 4;
+        static const size_t HeaderSize = sizeof(uint32_t);
+        static const size_t MaxSize = (1 << 24) - 1;
+
     private:
-        RenderingCommandKind m_Kind;
-        const union 
-        {
-            ColorRenderingCommandArguments m_ColorArgs;
-            FillPointRenderingCommandArguments m_FillPointArgs;
-            FillRectangleRenderingCommandArguments m_FillRectangleArgs;
-            StrokeRectangleRenderingCommandArguments m_StrokeRectangleArgs;
-            BeginPolygonRenderingCommandArguments m_BeginPolygonArgs;
-            VertexCommandArguments m_VertexArgs;
-            StrokePolygonRenderingCommandArguments m_StrokePolygonArgs;
-            FillPolygonRenderingCommandArguments m_FillPolygonArgs;
-            TextRenderingCommandArguments m_TextArgs;
-        };
+        const unsigned char* m_Data;
 
     public:
-        RenderingCommand(const ColorRenderingCommandArguments& args) : 
-            m_Kind(RenderingCommandKind::Color), m_ColorArgs(args) {}
-        
-        RenderingCommand(const FillPointRenderingCommandArguments& args) :
-            m_Kind(RenderingCommandKind::FillPoint), m_FillPointArgs(args) {}
-
-        RenderingCommand(const StrokeRectangleRenderingCommandArguments& args) :
-            m_Kind(RenderingCommandKind::StrokeRectangle), m_StrokeRectangleArgs(args) {}
-
-        RenderingCommand(const FillRectangleRenderingCommandArguments& args) :
-            m_Kind(RenderingCommandKind::FillRectangle), m_FillRectangleArgs(args) {}
-        
-        RenderingCommand(const BeginPolygonRenderingCommandArguments& args) :
-            m_Kind(RenderingCommandKind::BeginPolygon), m_BeginPolygonArgs(args) {}
-        
-        RenderingCommand(const VertexCommandArguments& args) :
-            m_Kind(RenderingCommandKind::Vertex), m_VertexArgs(args) {}
-        
-        RenderingCommand(const StrokePolygonRenderingCommandArguments& args) :
-            m_Kind(RenderingCommandKind::StrokePolygon), m_StrokePolygonArgs(args) {}
-        
-        RenderingCommand(const FillPolygonRenderingCommandArguments& args) :
-            m_Kind(RenderingCommandKind::FillPolygon), m_FillPolygonArgs(args) {}
-        
-        RenderingCommand(const TextRenderingCommandArguments& args) :
-            m_Kind(RenderingCommandKind::Text), m_TextArgs(args) {}
+        explicit RenderingCommand(const unsigned char* data) : m_Data(data) {}
 
         RenderingCommandKind GetKind() const {
-            return m_Kind;
+            return static_cast<RenderingCommandKind>(ReadHeader() & 0xFF);
+        }
+
+        /**
+         * @brief Returns the size of the record in bytes, including the header and the padding.
+         */
+        size_t GetSize() const {
+            return ReadHeader() >> 8;
         }
 
-        const ColorRenderingCommandArguments& GetColorArgs() const {
-            return m_ColorArgs;
+        ColorRenderingCommandArguments GetColorArgs() const {
+            return ReadArgs<ColorRenderingCommandArguments>();
         }
 
-        const FillPointRenderingCommandArguments& GetFillPointArgs() const {
-            return m_FillPointArgs;
+        FillPointRenderingCommandArguments GetFillPointArgs() const {
+            return ReadArgs<FillPointRenderingCommandArguments>();
         }
 
-        const StrokeRectangleRenderingCommandArguments& GetStrokeRectangleArgs() const {
-            return m_StrokeRectangleArgs;
+        StrokeRectangleRenderingCommandArguments GetStrokeRectangleArgs() const {
+            return ReadArgs<StrokeRectangleRenderingCommandArguments>();
         }
 
-        const FillRectangleRenderingCommandArguments& GetFillRectangleArgs() const {
-            return m_FillRectangleArgs;
+        FillRectangleRenderingCommandArguments GetFillRectangleArgs() const {
+            return ReadArgs<FillRectangleRenderingCommandArguments>();
         }
 
-        const BeginPolygonRenderingCommandArguments& GetBeginPolygonArgs() const {
-            return m_BeginPolygonArgs;
+        BeginPolygonRenderingCommandArguments GetBeginPolygonArgs() const {
+            return BeginPolygonRenderingCommandArguments();
         }
 
-        const VertexCommandArguments& GetVertexArgs() const {
-            return m_VertexArgs;
+        VertexCommandArguments GetVertexArgs() const {
+            return ReadArgs<VertexCommandArguments>();
+        }
+
+        StrokePolygonRenderingCommandArguments GetStrokePolygonArgs() const {
+            return StrokePolygonRenderingCommandArguments();
+        }
+
+        FillPolygonRenderingCommandArguments GetFillPolygonArgs() const {
+            return FillPolygonRenderingCommandArguments();
+        }
+
+        /**
+         * @brief Returns the arguments of a text command, whose `Text` points into the buffer.
+         */
+        TextRenderingCommandArguments GetTextArgs() const {
+            float position[2];
+            std::memcpy(position, m_Data + HeaderSize, sizeof(position));
+
+            TextRenderingCommandArguments args = {
+                .X = position[0],
+                .Y = position[1],
+                .Text = reinterpret_cast<const char*>(m_Data + HeaderSize + sizeof(position))
+            };
+
+            return args;
+        }
+
+        ImageRenderingCommandArguments GetImageArgs() const {
+            return ReadArgs<ImageRenderingCommandArguments>();
+        }
+
+        static uint32_t MakeHeader(RenderingCommandKind kind, size_t size) {
+            return static_cast<uint32_t>(kind) | static_cast<uint32_t>(size << 8);
+        }
+
+    private:
+        uint32_t ReadHeader() const {
+            uint32_t header;
+            std::memcpy(&header, m_Data, sizeof(header));
+
+            return header;
+        }
+
+        template <typename Args>
+        Args ReadArgs() const {
+            Args args;
+            std::memcpy(&args, m_Data + HeaderSize, sizeof(Args));
+
+            return args;
+        }
+    };
+
+    /**
+     * @brief A read-only range over the commands of a `RenderingCommandBuffer`, valid until the buffer changes.
+     */
+    class RenderingCommandList
+    {
+    public:
+        class Iterator
+        {
+        private:
+            const unsigned char* m_Data;
+
+        public:
+            explicit Iterator(const unsigned char* data) : m_Data(data) {}
+
+            RenderingCommand operator*() const {
+                return RenderingCommand(m_Data);
+            }
+
+            Iterator& operator++() {
+                m_Data += RenderingCommand(m_Data).GetSize();
+                return *this;
+            }
+
+            bool operator==(const Iterator& other) const {
+                return m_Data == other.m_Data;
+            }
+
+            bool operator!=(const Iterator& other) const {
+                return m_Data != other.m_Data;
+            }
+        };
+
+    private:
+        const unsigned char* m_Begin;
+        const unsigned char* m_End;
+        size_t m_Count;
+
+    public:
+        RenderingCommandList(const unsigned char* begin, const unsigned char* end, size_t count)
+            : m_Begin(begin), m_End(end), m_Count(count) {}
+
+        Iterator begin() const {
+            return Iterator(m_Begin);
         }
 
-        const StrokePolygonRenderingCommandArguments& GetStrokePolygonArgs() const {
-            return m_StrokePolygonArgs;
+        Iterator end() const {
+            return Iterator(m_End);
         }
 
-        const FillPolygonRenderingCommandArguments& GetFillPolygonArgs() const {
-            return m_FillPolygonArgs;
+        bool empty() const {
+            return m_Count == 0;
         }
 
-        const TextRenderingCommandArguments& GetTextArgs() const {
-            return m_TextArgs;
+        size_t size() const {
+            return m_Count;
         }
     };
 }
\ No newline at end of file
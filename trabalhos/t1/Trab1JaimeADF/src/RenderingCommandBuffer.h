@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+#include "RenderingCommand.h"
+
+/**
+ * @file RenderingCommandBuffer.h
+ * @brief Defines the RenderingCommandBuffer class, a linear arena that stores packed rendering commands.
+ */
+
+namespace yap
+{
+    /**
+     * @class RenderingCommandBuffer
+     * @brief Stores rendering commands as tightly packed, variable-length records in one block of memory.
+     *
+     * Commands are appended at the end of the block and never removed one by one. `Clear` only rewinds
+     * the buffer, keeping its memory, so a buffer refilled every frame stops allocating once it has grown
+     * to the size of a frame. Records hold no pointers into the buffer, which lets the block grow by copying
+     * and lets `Append` splice another buffer in with a single copy. See `RenderingCommand` for the layout.
+     */
+    class RenderingCommandBuffer
+    {
+    private:
+        static const size_t MinCapacity = 4096;
+
+        std::unique_ptr<unsigned char[]> m_Data;
+        size_t m_Size = 0;
+        size_t m_Capacity = 0;
+        size_t m_Count = 0;
+
+    public:
+        RenderingCommandBuffer() {}
+
+        RenderingCommandBuffer(const RenderingCommandBuffer& other)
+        {
+            Append(other);
+        }
+
+        RenderingCommandBuffer& operator=(const RenderingCommandBuffer& other)
+        {
+            if (this != &other)
+            {
+                Clear();
+                Append(other);
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Adds a command whose arguments are copied as they are.
+         */
+        template <typename Args>
+        void Push(RenderingCommandKind kind, const Args& args)
+        {
+            unsigned char* record = Allocate(kind, sizeof(Args));
+            std::memcpy(record + RenderingCommand::HeaderSize, &args, sizeof(Args));
+        }
+
+        /**
+         * @brief Adds a command without arguments.
+         */
+        void Push(RenderingCommandKind kind)
+        {
+            Allocate(kind, 0);
+        }
+
+        /**
+         * @brief Adds a text command, copying `text` into the buffer.
+         */
+        void PushText(float x, float y, const char* text)
+        {
+            float position[2] = { x, y };
+            size_t length = std::strlen(text);
+
+            unsigned char* record = Allocate(RenderingCommandKind::Text, sizeof(position) + length + 1);
+
+            std::memcpy(record + RenderingCommand::HeaderSize, position, sizeof(position));
+            std::memcpy(record + RenderingCommand::HeaderSize + sizeof(position), text, length + 1);
+        }
+
+        /**
+         * @brief Adds all the commands of `other`.
+         */
+        void Append(const RenderingCommandBuffer& other)
+        {
+            if (other.m_Size == 0)
+            {
+                return;
+            }
+
+            Reserve(m_Size + other.m_Size);
+            std::memcpy(m_Data.get() + m_Size, other.m_Data.get(), other.m_Size);
+
+            m_Size += other.m_Size;
+            m_Count += other.m_Count;
+        }
+
+        /**
+         * @brief Removes every command, keeping the memory for the next ones.
+         */
+        void Clear()
+        {
+            m_Size = 0;
+            m_Count = 0;
+        }
+
+        RenderingCommandList GetCommands() const
+        {
+            return RenderingCommandList(m_Data.get(), m_Data.get() + m_Size, m_Count);
+        }
+
+        /**
+         * @brief Returns how many bytes the commands take.
+         */
+        size_t GetSize() const
+        {
+            return m_Size;
+        }
+
+        size_t GetCapacity() const
+        {
+            return m_Capacity;
+        }
+
+    private:
+        unsigned char* Allocate(RenderingCommandKind kind, size_t argumentsSize)
+        {
+            size_t size = (RenderingCommand::HeaderSize + argumentsSize + RenderingCommand::Alignment - 1) & ~(RenderingCommand::Alignment - 1);
+
+            if (size > RenderingCommand::MaxSize)
+            {
+                throw std::runtime_error("Rendering command is too large");
+            }
+
+            Reserve(m_Size + size);
+
+            unsigned char* record = m_Data.get() + m_Size;
+
+            uint32_t header = RenderingCommand::MakeHeader(kind, size);
+            std::memcpy(record, &header, sizeof(header));
+
+            m_Size += size;
+            m_Count++;
+
+            return record;
+        }
+
+        void Reserve(size_t capacity)
+        {
+            if (capacity <= m_Capacity)
+            {
+                return;
+            }
+
+            size_t newCapacity = std::max(capacity, m_Capacity * 2);
+
+            if (newCapacity < MinCapacity)
+            {
+                newCapacity = MinCapacity;
+            }
+
+            std::unique_ptr<unsigned char[]> data(new unsigned char[newCapacity]);
+
+            if (m_Size > 0)
+            {
+                std::memcpy(data.get(), m_Data.get(), m_Size);
+            }
+
+            m_Data = std::move(data);
+            m_Capacity = newCapacity;
+        }
+    };
+}
@@ -1,9 +1,7 @@
 #pragma once
 
-#include <vector>
-
 #include "Vec2.h"
-#include "RenderingCommand.h"
+#include "RenderingCommandBuffer.h"
 
 #include "gl_canvas2d.h"
 
@@ -12,7 +10,7 @@
  * @brief Defines the RenderingContext class, which provides an interface for managing and issuing rendering commands.
  * 
  * The RenderingContext class allows users to define various rendering operations such as drawing shapes, text, and polygons.
- * Commands are stored in a queue and can be retrieved or cleared as needed.
+ * Commands are stored in a `RenderingCommandBuffer` and can be retrieved or cleared as needed.
  */
 
 namespace yap
@@ -24,7 +22,7 @@ namespace yap
     class RenderingContext
     {
     private:
-        std::vector<RenderingCommand> m_Commands;
+        RenderingCommandBuffer m_Commands;
     
     public:
         RenderingContext() {}
@@ -37,7 +35,7 @@ namespace yap
                 .B = color.B
             };
 
-            m_Commands.emplace_back(args);
+            m_Commands.Push(RenderingCommandKind::Color, args);
         }
 
         void FillPoint(const Vec2 &point)
@@ -47,7 +45,7 @@ namespace yap
                 .Y = point.Y
             };
 
-            m_Commands.emplace_back(args);
+            m_Commands.Push(RenderingCommandKind::FillPoint, args);
         }
 
         void StrokeRectangle(const Vec2 &position, const Vec2 &size, float strokeWidth = 1.0f)
@@ -60,7 +58,7 @@ namespace yap
                 .StrokeWidth = strokeWidth
             };
 
-            m_Commands.emplace_back(args);
+            m_Commands.Push(RenderingCommandKind::StrokeRectangle, args);
         }
 
         void FillRectangle(const Vec2 &position, const Vec2 &size)
@@ -72,14 +70,12 @@ namespace yap
                 .Height = size.Y
             };
 
-            m_Commands.emplace_back(args);
+            m_Commands.Push(RenderingCommandKind::FillRectangle, args);
         }
 
         void BeginPolygon()
         {
-            BeginPolygonRenderingCommandArguments args = {};
-
-            m_Commands.emplace_back(args);
+            m_Commands.Push(RenderingCommandKind::BeginPolygon);
         }
 
         void Vertex(const Vec2 &vertex)
@@ -89,32 +85,35 @@ namespace yap
                 .Y = vertex.Y
             };
 
-            m_Commands.emplace_back(args);
+            m_Commands.Push(RenderingCommandKind::Vertex, args);
         }
 
         void StrokePolygon()
         {
-            StrokePolygonRenderingCommandArguments args = {};
-
-            m_Commands.emplace_back(args);
+            m_Commands.Push(RenderingCommandKind::StrokePolygon);
         }
 
         void FillPolygon()
         {
-            FillPolygonRenderingCommandArguments args = {};
-
-            m_Commands.emplace_back(args);
+            m_Commands.Push(RenderingCommandKind::FillPolygon);
         }
 
         void Text(const Vec2 &position, const char *text)
         {
-            TextRenderingCommandArguments args = {
+            m_Commands.PushText(position.X, position.Y, text);
+        }
+
+        void Image(const Vec2 &position, int width, int height, const unsigned char *pixels)
+        {
+            ImageRenderingCommandArguments args = {
                 .X = position.X,
                 .Y = position.Y,
-                .Text = text
+                .Width = width,
+                .Height = height,
+                .Pixels = pixels
             };
 
-            m_Commands.emplace_back(args);
+            m_Commands.Push(RenderingCommandKind::Image, args);
         }
 
         void Line(const Vec2 &start, const Vec2 &end, float strokeWidth = 1.0f)
@@ -132,14 +131,23 @@ namespace yap
             FillPolygon();
         }
 
-        const std::vector<RenderingCommand>& GetCommands() const
+        /**
+         * @brief Appends the commands recorded by `other`. The pixels of its images are not copied, so
+         * they must outlive the execution of the commands.
+         */
+        void Append(const RenderingContext& other)
+        {
+            m_Commands.Append(other.m_Commands);
+        }
+
+        RenderingCommandList GetCommands() const
         {
-            return m_Commands;
+            return m_Commands.GetCommands();
         }
 
         void ClearCommands()
         {
-            m_Commands.clear();
+            m_Commands.Clear();
         }
     };
 }
\ No newline at end of file
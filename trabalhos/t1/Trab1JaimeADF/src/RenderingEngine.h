@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "gl_canvas2d.h"
+#include "Profiler.h"
 #include "RenderingCommand.h"
 
 /**
@@ -16,20 +17,55 @@ namespace yap
     /**
      * @class RenderingEngine
      * @brief A class responsible for executing a series of rendering commands to produce graphical output.
+     *
+     * Rectangles, points and filled polygons are not drawn one by one. They are turned into triangles with
+     * the current color baked into each vertex and accumulated in a batch, which is drawn with a single
+     * `CV::triangles` call when a command that cannot be batched (text, images or stroked polygons) comes
+     * up or the commands run out. Color changes only affect the vertices that follow, so they never break
+     * a batch.
      */
     class RenderingEngine
     {
     private:
+        struct BatchVertex
+        {
+            float X, Y;
+            float R, G, B;
+        };
+
+        static_assert(sizeof(BatchVertex) == 5 * sizeof(float), "CV::triangles expects tightly packed vertices");
+
         std::vector<float> m_VerticesX;
         std::vector<float> m_VerticesY;
 
+        std::vector<BatchVertex> m_Batch;
+
+        // OpenGL starts drawing in white.
+        ColorRenderingCommandArguments m_Color = { 1.0f, 1.0f, 1.0f };
+
+        int m_DrawCalls = 0;
+
     public:
-        void ExecuteCommands(const std::vector<RenderingCommand>& commands)
+        void ExecuteCommands(const RenderingCommandList& commands)
         {
+            ProfileScope scope("RenderingEngine::ExecuteCommands");
+
+            m_DrawCalls = 0;
+
             for (const auto& command : commands)
             {
                 ExecuteCommand(command);
             }
+
+            Flush();
+        }
+
+        /**
+         * @brief Returns how many draw calls the last `ExecuteCommands` issued.
+         */
+        int GetDrawCalls() const
+        {
+            return m_DrawCalls;
         }
     
     private:
@@ -64,12 +100,15 @@ namespace yap
                 case RenderingCommandKind::Text:
                     ExecuteTextCommand(command.GetTextArgs());
                     break;
+                case RenderingCommandKind::Image:
+                    ExecuteImageCommand(command.GetImageArgs());
+                    break;
             }
         }
 
         void ExecuteColorCommand(const ColorRenderingCommandArguments& args)
         {
-            CV::color(args.R, args.G, args.B);
+            m_Color = args;
 
             // printf(
             //    "Color(R = %.2f, G = %.2f, B = %.2f)\n",
@@ -81,8 +120,7 @@ namespace yap
 
         void ExecuteFillPointCommand(const FillPointRenderingCommandArguments& args)
         {
-            // CV::point(args.X, args.Y);
-            CV::rectFill(args.X, args.Y, args.X + 1, args.Y + 1);
+            BatchRectangle(args.X, args.Y, args.X + 1, args.Y + 1);
 
             // printf(
             //    "FillPoint(X = %f, Y = %f)\n",
@@ -93,11 +131,10 @@ namespace yap
 
         void ExecuteStrokeRectangleCommand(const StrokeRectangleRenderingCommandArguments& args)
         {
-            // CV::rect(args.X, args.Y, args.X + args.Width, args.Y + args.Height);
-            CV::rectFill(args.X, args.Y, args.X + args.Width, args.Y + args.StrokeWidth);
-            CV::rectFill(args.X, args.Y + args.Height - args.StrokeWidth, args.X + args.Width, args.Y + args.Height);
-            CV::rectFill(args.X, args.Y, args.X + args.StrokeWidth, args.Y + args.Height);
-            CV::rectFill(args.X + args.Width - args.StrokeWidth, args.Y, args.X + args.Width, args.Y + args.Height);
+            BatchRectangle(args.X, args.Y, args.X + args.Width, args.Y + args.StrokeWidth);
+            BatchRectangle(args.X, args.Y + args.Height - args.StrokeWidth, args.X + args.Width, args.Y + args.Height);
+            BatchRectangle(args.X, args.Y, args.X + args.StrokeWidth, args.Y + args.Height);
+            BatchRectangle(args.X + args.Width - args.StrokeWidth, args.Y, args.X + args.Width, args.Y + args.Height);
 
             // printf(
             //    "StrokeRectangle(X = %f, Y = %f, Width = %f, Height = %f)\n",
@@ -110,7 +147,7 @@ namespace yap
 
         void ExecuteFillRectangleCommand(const FillRectangleRenderingCommandArguments& args)
         {
-            CV::rectFill(args.X, args.Y, args.X + args.Width, args.Y + args.Height);
+            BatchRectangle(args.X, args.Y, args.X + args.Width, args.Y + args.Height);
 
             // printf(
             //    "FillRectangle(X = %f, Y = %f, Width = %f, Height = %f)\n",
@@ -148,8 +185,13 @@ namespace yap
                 return;
             }
 
+            Flush();
+
+            CV::color(m_Color.R, m_Color.G, m_Color.B);
             CV::polygon(m_VerticesX.data(), m_VerticesY.data(), m_VerticesX.size());
 
+            m_DrawCalls++;
+
             // printf("StrokePolygon()\n");
         }
 
@@ -160,15 +202,27 @@ namespace yap
                 return;
             }
 
-            CV::polygonFill(m_VerticesX.data(), m_VerticesY.data(), m_VerticesX.size());
+            // A fan covers the same pixels as `GL_POLYGON`, which is only defined for convex polygons too.
+            for (size_t i = 1; i + 1 < m_VerticesX.size(); ++i)
+            {
+                BatchVertexAt(m_VerticesX[0], m_VerticesY[0]);
+                BatchVertexAt(m_VerticesX[i], m_VerticesY[i]);
+                BatchVertexAt(m_VerticesX[i + 1], m_VerticesY[i + 1]);
+            }
 
             // printf("FillPolygon()\n");
         }
 
         void ExecuteTextCommand(const TextRenderingCommandArguments& args)
         {
+            Flush();
+
+            // The raster position picks up the current color, which the vertex colors of a batch leave undefined.
+            CV::color(m_Color.R, m_Color.G, m_Color.B);
             CV::text(args.X, args.Y, args.Text);
 
+            m_DrawCalls++;
+
             // printf(
             //    "Text(X = %f, Y = %f, Text = %s)\n",
             //    args.X,
@@ -176,5 +230,51 @@ namespace yap
             //    args.Text
             // );
         }
+
+        void ExecuteImageCommand(const ImageRenderingCommandArguments& args)
+        {
+            Flush();
+
+            CV::image(args.X, args.Y, args.Width, args.Height, args.Pixels);
+
+            m_DrawCalls++;
+
+            // printf(
+            //    "Image(X = %f, Y = %f, Width = %d, Height = %d)\n",
+            //    args.X,
+            //    args.Y,
+            //    args.Width,
+            //    args.Height
+            // );
+        }
+
+        void BatchRectangle(float x1, float y1, float x2, float y2)
+        {
+            BatchVertexAt(x1, y1);
+            BatchVertexAt(x1, y2);
+            BatchVertexAt(x2, y2);
+
+            BatchVertexAt(x1, y1);
+            BatchVertexAt(x2, y2);
+            BatchVertexAt(x2, y1);
+        }
+
+        void BatchVertexAt(float x, float y)
+        {
+            m_Batch.push_back({ x, y, m_Color.R, m_Color.G, m_Color.B });
+        }
+
+        void Flush()
+        {
+            if (m_Batch.empty())
+            {
+                return;
+            }
+
+            CV::triangles(&m_Batch[0].X, static_cast<int>(m_Batch.size()));
+            m_Batch.clear();
+
+            m_DrawCalls++;
+        }
     };
 }
\ No newline at end of file
@@ -41,6 +41,9 @@ namespace yap
             auto cancelButton = CreateTextButton("Cancelar");
             auto openButton = CreateTextButton("Salvar");
 
+            auto error = std::make_shared<Box>();
+            auto errorText = std::make_shared<Text>();
+
             label->Content = "Nome do arquivo: ";
 
             nameInput->SetValue("projeto.yap");
@@ -59,7 +62,7 @@ namespace yap
                 Close();
             };
 
-            openButton->OnMousePress = [this, project, fileSelector, nameInput](Element& e) {
+            openButton->OnMousePress = [this, project, fileSelector, nameInput, error, errorText](Element& e) {
                 std::string basePath = fileSelector->GetPath();
                 std::string fileName = nameInput->GetValue();
 
@@ -70,11 +73,29 @@ namespace yap
 
                 std::string path = Path::Join({ basePath, fileName });
 
-                project->Save(path);
+                try {
+                    project->Save(path);
+                } catch (const std::exception& e) {
+                    error->SetStyle(
+                        error->GetStyle()
+                            .WithSize(AxisSizingRule::Fit(), AxisSizingRule::Fit())
+                    );
+                    errorText->Content = "Erro ao salvar o projeto: " + std::string(e.what());
+                    return;
+                }
 
                 Close();
             };
 
+            error->SetStyle(
+                StyleSheet()
+                    .WithSize(AxisSizingRule::Fit(), AxisSizingRule::Fixed(0))
+                    .WithPadding(BoxPadding(8))
+                    .WithForeground(ColorRGB(255, 0, 0))
+            );
+
+            error->AddChild(errorText);
+
             buttons->SetStyle(
                 StyleSheet()
                     .WithSize(AxisSizingRule::Fill(), AxisSizingRule::Fit())
@@ -86,6 +107,7 @@ namespace yap
 
             body->AddChild(fileSelector);
             body->AddChild(field);
+            body->AddChild(error);
             body->AddChild(buttons);
 
             OnMount = [this, fileSelector](Element& element)
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 
+#include "Benchmark.h"
 #include "Element.h"
 #include "Box.h"
 #include "Mouse.h"
 #include "Keyboard.h"
+#include "Profiler.h"
 
 /**
  * @file Screen.h
@@ -22,6 +27,11 @@ namespace yap
      * The `Screen` class is responsible for handling user input (mouse and keyboard), managing the root
      * graphical element (`Box`), and rendering the graphical interface. It also provides mechanisms for
      * scheduling callbacks to be executed in the next frame.
+     *
+     * Frames are only rendered on demand. Input, `ExecuteNextFrame` and elements that animate request a
+     * frame through `RequestFrame` or `RequestFrameAfter`, and a frame in which anything had to be drawn
+     * again requests one more so the interface settles. The host asks `IsFrameRequested` before rendering
+     * and otherwise keeps presenting the previous frame.
      */
     class Screen : public std::enable_shared_from_this<Screen>
     {
@@ -32,10 +42,20 @@ namespace yap
         std::vector<std::function<void()>> m_CurrentFrameCallbacks;
         std::vector<std::function<void()>> m_NextFrameCallbacks;
 
+        std::mutex m_NextFrameMutex;
+
+        std::atomic<bool> m_FrameRequested;
+        std::chrono::steady_clock::time_point m_FrameDeadline;
+        bool m_Continuous = false;
+
+        Benchmark m_FrameBenchmark;
+        Benchmark m_RenderBenchmark;
+        Benchmark m_ExecuteBenchmark;
+
     public:
         std::shared_ptr<Box> Root;
 
-        Screen() : Root(std::make_shared<Box>())
+        Screen() : m_FrameRequested(true), m_FrameDeadline(std::chrono::steady_clock::time_point::max()), Root(std::make_shared<Box>())
         {
         }
 
@@ -54,6 +74,8 @@ namespace yap
 
         void ProcessMouseMove(float x, float y)
         {
+            RequestFrame();
+
             m_Mouse.Position.X = x;
             m_Mouse.Position.Y = y;
             Root->ProcessMouseMove(m_Mouse);
@@ -61,21 +83,29 @@ namespace yap
 
         void ProcessMouseUp(MouseButton button)
         {
+            RequestFrame();
+
             Root->ProcessMouseUp(m_Mouse, button);
         }
 
         void ProcessMouseDown(MouseButton button)
         {
+            RequestFrame();
+
             Root->ProcessMouseDown(m_Mouse, button);
         }
 
         void ProcessMouseScroll(MouseScrollDirection direction)
         {
+            RequestFrame();
+
             Root->ProcessMouseScroll(m_Mouse, direction);
         }
 
         void ProcessKeyboardDown(KeyboardKey key)
         {
+            RequestFrame();
+
             switch (key)
             {
                 case 212:
@@ -94,6 +124,8 @@ namespace yap
 
         void ProcessKeyboardUp(KeyboardKey key)
         {
+            RequestFrame();
+
             switch (key)
             {
                 case 212:
@@ -112,26 +144,110 @@ namespace yap
 
         void Render(RenderingContext& context)
         {
+            ProfileScope scope("Screen::Render");
+
+            // The time spent idle between frames is not a frame time, so only back-to-back frames are measured.
+            if (m_Continuous)
+            {
+                m_FrameBenchmark.Stop();
+            }
+
+            m_FrameBenchmark.Start();
+
+            m_FrameRequested = false;
+            m_FrameDeadline = std::chrono::steady_clock::time_point::max();
+
+            m_RenderBenchmark.Start();
+
             m_CurrentFrameCallbacks.clear();
 
-            std::swap(m_CurrentFrameCallbacks, m_NextFrameCallbacks);
+            {
+                std::lock_guard<std::mutex> lock(m_NextFrameMutex);
+                std::swap(m_CurrentFrameCallbacks, m_NextFrameCallbacks);
+            }
+
+            {
+                ProfileScope callbacksScope("Screen::ExecuteNextFrame");
+
+                for (const auto& callback : m_CurrentFrameCallbacks)
+                {
+                    callback();
+                }
+            }
+
+            {
+                ProfileScope animateScope("Element::Animate");
+                Root->Animate();
+            }
 
-            for (const auto& callback : m_CurrentFrameCallbacks)
             {
-                callback();
+                ProfileScope styleScope("Element::ComputeStyle");
+                Root->ComputeStyle(ComputedStyleSheet());
+            }
+
+            {
+                ProfileScope layoutScope("Element::Layout");
+
+                Root->ComputeIndependentDimensions();
+                Root->ComputeResponsiveDimensions();
+                Root->ComputePosition();
             }
 
-            Root->Animate();
-            Root->ComputeStyle(ComputedStyleSheet());
-            Root->ComputeIndependentDimensions();
-            Root->ComputeResponsiveDimensions();
-            Root->ComputePosition();
-            Root->Draw(context);
+            {
+                ProfileScope drawScope("Element::Draw");
+
+                if (Root->UpdateDirty())
+                {
+                    RequestFrame();
+                }
+
+                Root->Record(context);
+            }
+
+            m_RenderBenchmark.Stop();
+
+            m_Continuous = IsFrameRequested();
         }
 
+        /**
+         * @brief Schedules a callback to run on the UI thread at the start of the next frame. Safe to call from any thread.
+         */
         void ExecuteNextFrame(const std::function<void()>& callback)
         {
-            m_NextFrameCallbacks.emplace_back(callback);
+            {
+                std::lock_guard<std::mutex> lock(m_NextFrameMutex);
+                m_NextFrameCallbacks.emplace_back(callback);
+            }
+
+            RequestFrame();
+        }
+
+        /**
+         * @brief Asks for a new frame to be rendered. Safe to call from any thread.
+         */
+        void RequestFrame()
+        {
+            m_FrameRequested = true;
+        }
+
+        /**
+         * @brief Asks for a new frame once `seconds` have passed, for animations that change over time.
+         * Requests last until the next frame, so animations request again each frame they are running.
+         * Only call it from the UI thread.
+         */
+        void RequestFrameAfter(double seconds)
+        {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+
+            m_FrameDeadline = std::min(m_FrameDeadline, deadline);
+        }
+
+        /**
+         * @brief Whether anything requested a frame since the last one started.
+         */
+        bool IsFrameRequested() const
+        {
+            return m_FrameRequested || std::chrono::steady_clock::now() >= m_FrameDeadline;
         }
 
         const Mouse& GetMouse() const
@@ -143,5 +259,30 @@ namespace yap
         {
             return m_Keyboard;
         }
+
+        /**
+         * @brief Times the interval between the starts of consecutive frames.
+         */
+        const Benchmark& GetFrameBenchmark() const
+        {
+            return m_FrameBenchmark;
+        }
+
+        /**
+         * @brief Times `Render`, from the frame callbacks to recording the draw commands.
+         */
+        const Benchmark& GetRenderBenchmark() const
+        {
+            return m_RenderBenchmark;
+        }
+
+        /**
+         * @brief Times the execution of the recorded commands, which happens outside the screen; the caller
+         * that executes them is expected to start and stop it.
+         */
+        Benchmark& GetExecuteBenchmark()
+        {
+            return m_ExecuteBenchmark;
+        }
     };
 }
\ No newline at end of file
@@ -90,7 +90,7 @@ namespace yap
 
                 std::string path = Path::Join({ basePath, fileName });
 
-                const Bitmap& bitmap = *project->RenderCanvas();
+                const Bitmap& bitmap = *project->RenderCanvas(true);
 
                 BMP::Save(path, bitmap, alphaCheckbox->IsChecked());
 
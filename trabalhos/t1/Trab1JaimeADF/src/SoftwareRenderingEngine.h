@@ -0,0 +1,381 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Bitmap.h"
+#include "BitmapFont.h"
+#include "Color.h"
+#include "Profiler.h"
+#include "RenderingCommand.h"
+#include "ThreadPool.h"
+#include "Vec2.h"
+
+/**
+ * @file SoftwareRenderingEngine.h
+ * @brief Defines the SoftwareRenderingEngine class, which executes rendering commands into a bitmap on the CPU.
+ */
+
+namespace yap
+{
+    /**
+     * @class SoftwareRenderingEngine
+     * @brief Executes the same commands as `RenderingEngine`, but rasterizes them into a `Bitmap` instead of
+     * drawing through OpenGL, so frames can be rendered and inspected without a display.
+     *
+     * The rules follow what OpenGL does with the commands `RenderingEngine` issues: rectangles and polygons
+     * cover the pixels whose centers are inside them, with polygons filled by the even-odd rule so concave
+     * ones work too; stroked polygons are one pixel wide lines; text uses the GLUT 8x13 font from
+     * `BitmapFont`, spaced like `CV::text`; and images are copied without blending. Everything is opaque.
+     *
+     * The target is split into bands of `Bitmap::TileSize` rows, which are rasterized in parallel on the
+     * shared thread pool. Each band walks the whole command list, clipping every command to its rows, into
+     * a private buffer in which every command becomes runs of pixels filled at once, and then writes the
+     * buffer back to its own row of tiles.
+     */
+    class SoftwareRenderingEngine
+    {
+    private:
+        static const int BandHeight = Bitmap::TileSize;
+
+        class BandRasterizer
+        {
+        private:
+            ColorRGBA8* m_Pixels;
+            int m_Width;
+            int m_Top;
+            int m_Bottom;
+
+            ColorRGBA8 m_Color;
+
+            std::vector<Vec2> m_Vertices;
+            std::vector<float> m_Crossings;
+
+        public:
+            BandRasterizer(ColorRGBA8* pixels, int width, int top, int bottom, const ColorRGBA8& color)
+                : m_Pixels(pixels), m_Width(width), m_Top(top), m_Bottom(bottom), m_Color(color)
+            {
+            }
+
+            void Execute(const RenderingCommand& command)
+            {
+                switch (command.GetKind())
+                {
+                    case RenderingCommandKind::Color:
+                    {
+                        const ColorRenderingCommandArguments& args = command.GetColorArgs();
+                        m_Color = ColorRGBA8(ColorRGBA(args.R, args.G, args.B));
+                        break;
+                    }
+                    case RenderingCommandKind::FillPoint:
+                    {
+                        const FillPointRenderingCommandArguments& args = command.GetFillPointArgs();
+                        FillRectangle(args.X, args.Y, args.X + 1, args.Y + 1);
+                        break;
+                    }
+                    case RenderingCommandKind::StrokeRectangle:
+                    {
+                        const StrokeRectangleRenderingCommandArguments& args = command.GetStrokeRectangleArgs();
+
+                        FillRectangle(args.X, args.Y, args.X + args.Width, args.Y + args.StrokeWidth);
+                        FillRectangle(args.X, args.Y + args.Height - args.StrokeWidth, args.X + args.Width, args.Y + args.Height);
+                        FillRectangle(args.X, args.Y, args.X + args.StrokeWidth, args.Y + args.Height);
+                        FillRectangle(args.X + args.Width - args.StrokeWidth, args.Y, args.X + args.Width, args.Y + args.Height);
+                        break;
+                    }
+                    case RenderingCommandKind::FillRectangle:
+                    {
+                        const FillRectangleRenderingCommandArguments& args = command.GetFillRectangleArgs();
+                        FillRectangle(args.X, args.Y, args.X + args.Width, args.Y + args.Height);
+                        break;
+                    }
+                    case RenderingCommandKind::BeginPolygon:
+                        m_Vertices.clear();
+                        break;
+                    case RenderingCommandKind::Vertex:
+                    {
+                        const VertexCommandArguments& args = command.GetVertexArgs();
+                        m_Vertices.push_back(Vec2(args.X, args.Y));
+                        break;
+                    }
+                    case RenderingCommandKind::StrokePolygon:
+                        StrokePolygon();
+                        break;
+                    case RenderingCommandKind::FillPolygon:
+                        FillPolygon();
+                        break;
+                    case RenderingCommandKind::Text:
+                    {
+                        const TextRenderingCommandArguments& args = command.GetTextArgs();
+                        Text(args.X, args.Y, args.Text);
+                        break;
+                    }
+                    case RenderingCommandKind::Image:
+                    {
+                        const ImageRenderingCommandArguments& args = command.GetImageArgs();
+                        Image(args.X, args.Y, args.Width, args.Height, args.Pixels);
+                        break;
+                    }
+                }
+            }
+
+        private:
+            // A pixel is covered when its center is, so an edge at `x` starts covering at `ceil(x - 0.5)`.
+            static int ToPixelEdge(float coordinate)
+            {
+                return static_cast<int>(std::ceil(coordinate - 0.5f));
+            }
+
+            void FillSpan(int y, int left, int right)
+            {
+                left = std::max(left, 0);
+                right = std::min(right, m_Width);
+
+                if (y < m_Top || y >= m_Bottom || left >= right)
+                {
+                    return;
+                }
+
+                ColorRGBA8* row = m_Pixels + static_cast<size_t>(y - m_Top) * m_Width;
+                std::fill(row + left, row + right, m_Color);
+            }
+
+            void Plot(int x, int y)
+            {
+                if (x < 0 || x >= m_Width || y < m_Top || y >= m_Bottom)
+                {
+                    return;
+                }
+
+                m_Pixels[static_cast<size_t>(y - m_Top) * m_Width + x] = m_Color;
+            }
+
+            void FillRectangle(float x1, float y1, float x2, float y2)
+            {
+                int left = ToPixelEdge(std::min(x1, x2));
+                int right = ToPixelEdge(std::max(x1, x2));
+                int top = std::max(ToPixelEdge(std::min(y1, y2)), m_Top);
+                int bottom = std::min(ToPixelEdge(std::max(y1, y2)), m_Bottom);
+
+                for (int y = top; y < bottom; ++y)
+                {
+                    FillSpan(y, left, right);
+                }
+            }
+
+            void FillPolygon()
+            {
+                if (m_Vertices.size() < 3)
+                {
+                    return;
+                }
+
+                float minY = m_Vertices[0].Y;
+                float maxY = m_Vertices[0].Y;
+
+                for (const Vec2& vertex : m_Vertices)
+                {
+                    minY = std::min(minY, vertex.Y);
+                    maxY = std::max(maxY, vertex.Y);
+                }
+
+                int top = std::max(ToPixelEdge(minY), m_Top);
+                int bottom = std::min(ToPixelEdge(maxY), m_Bottom);
+
+                for (int y = top; y < bottom; ++y)
+                {
+                    float center = y + 0.5f;
+
+                    m_Crossings.clear();
+
+                    for (size_t i = 0; i < m_Vertices.size(); ++i)
+                    {
+                        const Vec2& start = m_Vertices[i];
+                        const Vec2& end = m_Vertices[(i + 1) % m_Vertices.size()];
+
+                        if ((start.Y <= center) != (end.Y <= center))
+                        {
+                            m_Crossings.push_back(start.X + (center - start.Y) * (end.X - start.X) / (end.Y - start.Y));
+                        }
+                    }
+
+                    std::sort(m_Crossings.begin(), m_Crossings.end());
+
+                    for (size_t i = 0; i + 1 < m_Crossings.size(); i += 2)
+                    {
+                        FillSpan(y, ToPixelEdge(m_Crossings[i]), ToPixelEdge(m_Crossings[i + 1]));
+                    }
+                }
+            }
+
+            void StrokePolygon()
+            {
+                if (m_Vertices.size() < 2)
+                {
+                    return;
+                }
+
+                for (size_t i = 0; i < m_Vertices.size(); ++i)
+                {
+                    const Vec2& start = m_Vertices[i];
+                    const Vec2& end = m_Vertices[(i + 1) % m_Vertices.size()];
+
+                    Line(
+                        static_cast<int>(std::floor(start.X)), static_cast<int>(std::floor(start.Y)),
+                        static_cast<int>(std::floor(end.X)), static_cast<int>(std::floor(end.Y))
+                    );
+                }
+            }
+
+            void Line(int x1, int y1, int x2, int y2)
+            {
+                int dx = std::abs(x2 - x1);
+                int dy = -std::abs(y2 - y1);
+                int stepX = x1 < x2 ? 1 : -1;
+                int stepY = y1 < y2 ? 1 : -1;
+                int error = dx + dy;
+
+                while (true)
+                {
+                    Plot(x1, y1);
+
+                    if (x1 == x2 && y1 == y2)
+                    {
+                        break;
+                    }
+
+                    int doubledError = 2 * error;
+
+                    if (doubledError >= dy)
+                    {
+                        error += dy;
+                        x1 += stepX;
+                    }
+
+                    if (doubledError <= dx)
+                    {
+                        error += dx;
+                        y1 += stepY;
+                    }
+                }
+            }
+
+            void Text(float x, float y, const char* text)
+            {
+                // `CV::text` sets the raster position with integers, which truncates the coordinates.
+                int baseline = static_cast<int>(y);
+                int top = baseline + BitmapFont::Descent - BitmapFont::GlyphHeight;
+
+                if (top >= m_Bottom || top + BitmapFont::GlyphHeight <= m_Top)
+                {
+                    return;
+                }
+
+                for (int index = 0; text[index] != '\0'; ++index)
+                {
+                    int left = static_cast<int>(x + index * BitmapFont::Advance);
+                    const uint8_t* glyph = BitmapFont::GetGlyph(static_cast<unsigned char>(text[index]));
+
+                    for (int row = 0; row < BitmapFont::GlyphHeight; ++row)
+                    {
+                        for (int column = 0; column < BitmapFont::GlyphWidth; ++column)
+                        {
+                            if (glyph[row] & (0x80 >> column))
+                            {
+                                Plot(left + column, top + row);
+                            }
+                        }
+                    }
+                }
+            }
+
+            void Image(float x, float y, int width, int height, const unsigned char* pixels)
+            {
+                if (width <= 0 || height <= 0)
+                {
+                    return;
+                }
+
+                int left = ToPixelEdge(x);
+                int top = ToPixelEdge(y);
+
+                int firstColumn = std::max(0, -left);
+                int lastColumn = std::min(width, m_Width - left);
+
+                int firstRow = std::max(top, m_Top);
+                int lastRow = std::min(top + height, m_Bottom);
+
+                for (int y = firstRow; y < lastRow; ++y)
+                {
+                    const unsigned char* source = pixels + (static_cast<size_t>(y - top) * width + firstColumn) * 4;
+                    ColorRGBA8* destination = m_Pixels + static_cast<size_t>(y - m_Top) * m_Width + left + firstColumn;
+
+                    for (int column = firstColumn; column < lastColumn; ++column, source += 4)
+                    {
+                        *destination++ = ColorRGBA8(source[0], source[1], source[2]);
+                    }
+                }
+            }
+        };
+
+        std::vector<std::vector<ColorRGBA8>> m_Bands;
+
+        // OpenGL starts drawing in white, and keeps the last color between frames.
+        ColorRGBA8 m_Color = ColorRGBA8(255, 255, 255);
+
+    public:
+        /**
+         * @brief Draws `commands` over the current pixels of `target`.
+         */
+        void ExecuteCommands(const RenderingCommandList& commands, Bitmap& target)
+        {
+            ProfileScope scope("SoftwareRenderingEngine::ExecuteCommands");
+
+            int width = target.GetWidth();
+            int height = target.GetHeight();
+
+            if (width <= 0 || height <= 0)
+            {
+                return;
+            }
+
+            int bandCount = (height + BandHeight - 1) / BandHeight;
+            m_Bands.resize(bandCount);
+
+            ThreadPool::GetShared().ParallelFor(bandCount, [&](int index) {
+                int top = index * BandHeight;
+                int bottom = std::min(top + BandHeight, height);
+
+                std::vector<ColorRGBA8>& pixels = m_Bands[index];
+                pixels.resize(static_cast<size_t>(width) * BandHeight);
+
+                for (int y = top; y < bottom; ++y)
+                {
+                    target.ReadSpan(0, y, width, &pixels[static_cast<size_t>(y - top) * width]);
+                }
+
+                BandRasterizer rasterizer(pixels.data(), width, top, bottom, m_Color);
+
+                for (const auto& command : commands)
+                {
+                    rasterizer.Execute(command);
+                }
+
+                for (int y = top; y < bottom; ++y)
+                {
+                    target.WriteSpan(0, y, width, &pixels[static_cast<size_t>(y - top) * width]);
+                }
+            });
+
+            for (const auto& command : commands)
+            {
+                if (command.GetKind() == RenderingCommandKind::Color)
+                {
+                    const ColorRenderingCommandArguments& args = command.GetColorArgs();
+                    m_Color = ColorRGBA8(ColorRGBA(args.R, args.G, args.B));
+                }
+            }
+        }
+    };
+}
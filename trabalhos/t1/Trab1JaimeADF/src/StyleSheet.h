@@ -260,6 +260,23 @@ namespace yap
             }
         }
 
+        /**
+         * @brief Whether an element drawn with either style looks the same. Rules that only affect layout or
+         * events are ignored, since their effect shows up in the position and size of the element.
+         */
+        bool HasSameAppearance(const ComputedStyleSheet& style) const
+        {
+            return (
+                Visibility == style.Visibility &&
+                Foreground == style.Foreground &&
+                Background == style.Background &&
+                BackgroundReference == style.BackgroundReference &&
+                BackgroundSize == style.BackgroundSize &&
+                BackgroundPosition == style.BackgroundPosition &&
+                Border == style.Border
+            );
+        }
+
         void Reset()
         {
             Visibility = true;
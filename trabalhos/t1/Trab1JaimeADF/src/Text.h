@@ -25,6 +25,10 @@ namespace yap
      */
     class Text : public Element
     {
+    private:
+        // The recorded command points into this copy, which only changes when the text is drawn again.
+        std::string m_RecordedContent;
+
     public:
         std::string Content;
 
@@ -50,13 +54,21 @@ namespace yap
 
         void Draw(RenderingContext& context) override
         {
+            m_RecordedContent = Content;
+
             if (!ComputedStyle.Visibility)
             {
                 return;
             }
 
             context.Color(ComputedStyle.Foreground);
-            context.Text(Position + Vec2(0.0f, 11.0f), Content.c_str());
+            context.Text(Position + Vec2(0.0f, 11.0f), m_RecordedContent.c_str());
+        }
+
+    protected:
+        bool IsContentDirty() const override
+        {
+            return Content != m_RecordedContent;
         }
     
     private:
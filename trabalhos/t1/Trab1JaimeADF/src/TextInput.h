@@ -4,6 +4,7 @@
 
 #include "Box.h"
 #include "Text.h"
+#include "Screen.h"
 
 /**
  * @file TextInput.h
@@ -72,6 +73,9 @@ namespace yap
                         m_Cursor->GetStyle()
                             .WithVisibility(ms % 1000 < 500)
                     );
+
+                    // Wake up again when the cursor blinks.
+                    GetScreen()->RequestFrameAfter((500 - ms % 500) / 1000.0);
                 }
                 else
                 {
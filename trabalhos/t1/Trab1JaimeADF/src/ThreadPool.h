@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Profiler.h"
+
+/**
+ * @file ThreadPool.h
+ * @brief Defines the ThreadPool class, a fixed set of worker threads used to run CPU-bound work in parallel.
+ */
+
+namespace yap
+{
+    /**
+     * @class ThreadPool
+     * @brief Runs queued tasks on a fixed number of worker threads.
+     *
+     * Besides fire-and-forget tasks, the pool offers `ParallelFor`, which splits a range of indices among the
+     * workers and the calling thread. Since the caller also claims indices, `ParallelFor` may be called from
+     * inside a task without deadlocking, even when every worker is busy.
+     */
+    class ThreadPool
+    {
+    private:
+        std::vector<std::thread> m_Workers;
+        std::queue<std::function<void()>> m_Tasks;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+
+        bool m_Stopping = false;
+
+    public:
+        explicit ThreadPool(size_t threadCount)
+        {
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                m_Workers.emplace_back([this, i]() {
+                    Profiler::Get().SetThreadName("Pool worker " + std::to_string(i + 1));
+                    RunWorker();
+                });
+            }
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Stopping = true;
+            }
+
+            m_Condition.notify_all();
+
+            for (auto& worker : m_Workers)
+            {
+                worker.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void Enqueue(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Tasks.push(std::move(task));
+            }
+
+            m_Condition.notify_one();
+        }
+
+        /**
+         * @brief Calls `body(i)` for every `i` in `[0, count)`, blocking until all calls have returned.
+         *
+         * Indices are claimed dynamically, so uneven work is balanced between threads. If any call throws,
+         * the first exception is rethrown on the calling thread once every claimed index has finished.
+         */
+        void ParallelFor(int count, const std::function<void(int)>& body)
+        {
+            if (count <= 0)
+            {
+                return;
+            }
+
+            if (count == 1 || m_Workers.empty())
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    body(i);
+                }
+
+                return;
+            }
+
+            struct State
+            {
+                const std::function<void(int)>* Body;
+                int Count;
+
+                std::atomic<int> Next;
+                std::atomic<int> Completed;
+
+                std::mutex Mutex;
+                std::condition_variable Condition;
+                std::exception_ptr Error;
+            };
+
+            auto state = std::make_shared<State>();
+            state->Body = &body;
+            state->Count = count;
+            state->Next = 0;
+            state->Completed = 0;
+
+            // Helpers may start after every index was claimed; in that case they return without touching
+            // `Body`, which is only guaranteed to be alive while indices remain.
+            auto work = [state]() {
+                int index;
+
+                while ((index = state->Next.fetch_add(1)) < state->Count)
+                {
+                    try
+                    {
+                        (*state->Body)(index);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(state->Mutex);
+
+                        if (!state->Error)
+                        {
+                            state->Error = std::current_exception();
+                        }
+                    }
+
+                    if (state->Completed.fetch_add(1) + 1 == state->Count)
+                    {
+                        std::lock_guard<std::mutex> lock(state->Mutex);
+                        state->Condition.notify_all();
+                    }
+                }
+            };
+
+            size_t helperCount = std::min(m_Workers.size(), static_cast<size_t>(count - 1));
+
+            for (size_t i = 0; i < helperCount; ++i)
+            {
+                Enqueue(work);
+            }
+
+            work();
+
+            std::unique_lock<std::mutex> lock(state->Mutex);
+            state->Condition.wait(lock, [&state]() { return state->Completed.load() == state->Count; });
+
+            if (state->Error)
+            {
+                std::rethrow_exception(state->Error);
+            }
+        }
+
+        size_t GetThreadCount() const
+        {
+            return m_Workers.size();
+        }
+
+        /**
+         * @brief Returns the pool shared by the whole application, sized to leave one core for the calling thread.
+         */
+        static ThreadPool& GetShared()
+        {
+            static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+            return pool;
+        }
+
+    private:
+        void RunWorker()
+        {
+            while (true)
+            {
+                std::function<void()> task;
+
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    m_Condition.wait(lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+
+                    if (m_Stopping && m_Tasks.empty())
+                    {
+                        return;
+                    }
+
+                    task = std::move(m_Tasks.front());
+                    m_Tasks.pop();
+                }
+
+                task();
+            }
+        }
+    };
+}
@@ -8,6 +8,7 @@
 #include "Screen.h"
 #include "Text.h"
 #include "Slider.h"
+#include "Checkbox.h"
 
 #include "LayerBoundary.h"
 
@@ -93,6 +94,12 @@ namespace yap
                     }
 
                     m_CanvasOffset = mouseCanvasPosition - layer->GetPosition();
+                    m_Project->GetHistory().Begin(layer);
+                };
+
+                OnMouseRelease = [this](Element& element)
+                {
+                    m_Project->GetHistory().Commit();
                 };
 
                 OnMouseMove = [this](Element& element)
@@ -314,8 +321,12 @@ namespace yap
 
                     if (layer)
                     {
+                        m_Project->GetHistory().Begin(layer);
+
                         layer->SetPosition(m_TargetCanvasPosition);
                         layer->Scale(m_TargetCanvasSize, ScalingMethod::NearestNeighbor);
+
+                        m_Project->GetHistory().Commit();
                     }
 
                     m_Scaling = false;
@@ -498,6 +509,12 @@ namespace yap
 
             Vec2 m_LastMousePosition;
 
+            bool m_RecordedActiveLayer = false;
+            std::vector<Vec2> m_RecordedCanvasCorners;
+            Vec2 m_RecordedCanvasPivot;
+            float m_RecordedCanvasRotation = 0.0f;
+            Vec2 m_RecordedViewportOrigin;
+
         public:
             RotateToolOverlay(std::shared_ptr<Project> project, std::shared_ptr<ViewportSpace> viewportSpace)
                 : m_Project(project), m_ViewportSpace(viewportSpace), m_CanvasCorners(4), m_ScreenCorners(4)
@@ -567,7 +584,10 @@ namespace yap
 
                     if (activeLayer)
                     {
+                        m_Project->GetHistory().Begin(activeLayer);
                         activeLayer->Rotate(m_CanvasRotation, m_CanvasPivot);
+                        m_Project->GetHistory().Commit();
+
                         m_CanvasRotation = 0.0f;
                     }
                 };
@@ -577,6 +597,12 @@ namespace yap
             {
                 std::shared_ptr<Layer> activeLayer = m_Project->GetActiveLayer();
 
+                m_RecordedActiveLayer = activeLayer != nullptr;
+                m_RecordedCanvasCorners = m_CanvasCorners;
+                m_RecordedCanvasPivot = m_CanvasPivot;
+                m_RecordedCanvasRotation = m_CanvasRotation;
+                m_RecordedViewportOrigin = m_ViewportSpace->ConvertCanvasToScreenCoordinates(Vec2());
+
                 if (!activeLayer)
                 {
                     return;
@@ -623,6 +649,20 @@ namespace yap
                 context.Line(m_ScreenCorners[2], m_ScreenCorners[0], 2.0f);
             }
 
+        protected:
+            // The gizmo follows the active layer, the viewport and the drag in progress; the bounds are
+            // derived from the corners, so comparing those covers everything `Draw` reads.
+            bool IsContentDirty() const override
+            {
+                return (
+                    (m_Project->GetActiveLayer() != nullptr) != m_RecordedActiveLayer ||
+                    m_CanvasCorners != m_RecordedCanvasCorners ||
+                    m_CanvasPivot != m_RecordedCanvasPivot ||
+                    m_CanvasRotation != m_RecordedCanvasRotation ||
+                    m_ViewportSpace->ConvertCanvasToScreenCoordinates(Vec2()) != m_RecordedViewportOrigin
+                );
+            }
+
         private:
             void RefreshBounds()
             {
@@ -717,6 +757,8 @@ namespace yap
 
                     if (activeLayer)
                     {
+                        m_Project->GetHistory().Begin(activeLayer);
+
                         m_Brush->Apply(
                             activeLayer,
                             m_ViewportSpace->ConvertScreenToCanvasCoordinates(mouse.Position)
@@ -726,6 +768,11 @@ namespace yap
                     m_LastMousePosition = mouse.Position;
                 };
 
+                OnMouseRelease = [this](Element& element)
+                {
+                    m_Project->GetHistory().Commit();
+                };
+
                 OnMouseMove = [this](Element& element)
                 {
                     const Mouse& mouse = element.GetScreen()->GetMouse();
@@ -883,23 +930,33 @@ namespace yap
     class BucketTool : public Tool
     {
     private:
-        std::shared_ptr<ColorPalette> m_ColorPalette;
+        /**
+         * @struct BucketSettings
+         * @brief Options shared between the bucket overlay and its options bar.
+         */
+        struct BucketSettings
+        {
+            float Tolerance = 0.0f;
+            bool SampleCanvas = false;
+        };
 
+        std::shared_ptr<ColorPalette> m_ColorPalette;
+        std::shared_ptr<BucketSettings> m_Settings;
 
     public:
         BucketTool(const std::shared_ptr<Project>& project, const std::shared_ptr<ViewportSpace>& viewportSpace, const std::shared_ptr<ColorPalette>& colorPalette)
-            : Tool(project, viewportSpace), m_ColorPalette(colorPalette)
+            : Tool(project, viewportSpace), m_ColorPalette(colorPalette), m_Settings(std::make_shared<BucketSettings>())
         {
         }
 
         std::shared_ptr<Element> CreateOverlay() override
         {
-            return std::make_shared<BucketToolOverlay>(m_Project, m_ViewportSpace, m_ColorPalette);
+            return std::make_shared<BucketToolOverlay>(m_Project, m_ViewportSpace, m_ColorPalette, m_Settings);
         }
 
         std::shared_ptr<Element> CreateOptions() override
         {
-            return std::make_shared<Box>();
+            return std::make_shared<BucketToolOptions>(m_Settings);
         }
 
     private:
@@ -910,10 +967,11 @@ namespace yap
             std::shared_ptr<ViewportSpace> m_ViewportSpace;
 
             std::shared_ptr<ColorPalette> m_ColorPalette;
+            std::shared_ptr<BucketSettings> m_Settings;
 
         public:
-            BucketToolOverlay(std::shared_ptr<Project> project, std::shared_ptr<ViewportSpace> viewportSpace, std::shared_ptr<ColorPalette> colorPalette)
-                : m_Project(project), m_ViewportSpace(viewportSpace), m_ColorPalette(colorPalette)
+            BucketToolOverlay(std::shared_ptr<Project> project, std::shared_ptr<ViewportSpace> viewportSpace, std::shared_ptr<ColorPalette> colorPalette, std::shared_ptr<BucketSettings> settings)
+                : m_Project(project), m_ViewportSpace(viewportSpace), m_ColorPalette(colorPalette), m_Settings(settings)
             {
                 SetStyle(
                     StyleSheet()
@@ -933,13 +991,89 @@ namespace yap
 
                         ColorRGB fillColor = m_ColorPalette->GetGlobalColor();
 
-                        activeLayer->Fill(canvasPosition, fillColor);
+                        std::shared_ptr<const Bitmap> reference;
+
+                        if (m_Settings->SampleCanvas)
+                        {
+                            reference = m_Project->RenderCanvas(true);
+                        }
+
+                        m_Project->GetHistory().Begin(activeLayer);
+                        activeLayer->Fill(canvasPosition, fillColor, m_Settings->Tolerance, reference.get());
+                        m_Project->GetHistory().Commit();
                     }
                 };
 
                 AddChild(std::make_shared<LayerBoundary>(m_Project, m_ViewportSpace));
             }
         };
+
+        class BucketToolOptions : public Box
+        {
+        public:
+            BucketToolOptions(std::shared_ptr<BucketSettings> settings)
+            {
+                auto toleranceLabel = std::make_shared<Text>();
+                auto toleranceSlider = std::make_shared<Slider>();
+                auto toleranceValue = std::make_shared<Text>();
+
+                auto sampleField = std::make_shared<Box>();
+                auto sampleCheckbox = std::make_shared<Checkbox>();
+                auto sampleLabel = std::make_shared<Text>();
+
+                toleranceLabel->Content = "Tolerancia:";
+                toleranceValue->Content = std::to_string(static_cast<int>(std::round(settings->Tolerance * 100.0f))) + "%";
+
+                toleranceSlider->MinValue = 0.0f;
+                toleranceSlider->MaxValue = 100.0f;
+                toleranceSlider->Step = 1.0f;
+                toleranceSlider->SetValue(settings->Tolerance * 100.0f);
+
+                toleranceSlider->SetStyle(
+                    toleranceSlider->GetStyle()
+                        .WithSize(AxisSizingRule::Fixed(127), AxisSizingRule::Fixed(16))
+                );
+
+                toleranceSlider->OnChange = [settings, toleranceValue](Slider& slider, float value)
+                {
+                    int percentage = static_cast<int>(value);
+
+                    settings->Tolerance = percentage / 100.0f;
+                    toleranceValue->Content = std::to_string(percentage) + "%";
+                };
+
+                sampleField->SetStyle(
+                    StyleSheet()
+                        .WithSize(AxisSizingRule::Fit(), AxisSizingRule::Fit())
+                        .WithAlignment(BoxAxisAlignment::Start, BoxAxisAlignment::Center)
+                        .WithGap(8)
+                );
+
+                sampleLabel->Content = "Amostrar todas as camadas";
+
+                sampleCheckbox->SetChecked(settings->SampleCanvas);
+                sampleCheckbox->OnChange = [settings](Checkbox& checkbox, bool checked)
+                {
+                    settings->SampleCanvas = checked;
+                };
+
+                sampleField->AddChild(sampleCheckbox);
+                sampleField->AddChild(sampleLabel);
+
+                SetStyle(
+                    StyleSheet()
+                        .WithSize(AxisSizingRule::Fill(), AxisSizingRule::Fill())
+                        .WithAlignment(BoxAxisAlignment::Start, BoxAxisAlignment::Center)
+                        .WithForeground(ColorRGB(255, 255, 255))
+                        .WithGap(16)
+                );
+
+                AddChild(toleranceLabel);
+                AddChild(toleranceSlider);
+                AddChild(toleranceValue);
+                AddChild(sampleField);
+            }
+        };
     };
     
     /**
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+
 #include "Axis.h"
 
 /**
@@ -100,6 +102,16 @@ namespace yap
             Y = floor(Y);
         }
 
+        bool operator==(const Vec2& other) const
+        {
+            return X == other.X && Y == other.Y;
+        }
+
+        bool operator!=(const Vec2& other) const
+        {
+            return !(*this == other);
+        }
+
         Vec2& operator+=(const Vec2& other)
         {
             X += other.X;
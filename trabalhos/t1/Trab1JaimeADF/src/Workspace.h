@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdio>
+
+#include "Profiler.h"
 #include "Project.h"
 
 #include "ModalStack.h"
@@ -11,6 +14,7 @@
 #include "FileModal.h"
 #include "SaveModal.h"
 #include "ShareModal.h"
+#include "PerformanceOverlay.h"
 
 /*
  * @file Workspace.h
@@ -30,6 +34,14 @@ namespace yap
     class Workspace : public Box
     {
     private:
+        // GLUT reports Ctrl+Z, Ctrl+Y and Ctrl+P as the ASCII control characters they map to.
+        static const KeyboardKey UndoKey = 26;
+        static const KeyboardKey RedoKey = 25;
+        static const KeyboardKey ProfileKey = 16;
+
+        static constexpr const char* TracePath = "yap-trace.json";
+        static constexpr double LoadingRefreshInterval = 0.05;
+
         std::shared_ptr<Project> m_Project;
         std::shared_ptr<ColorPalette> m_ColorPalette;
         std::shared_ptr<ViewportSpace> m_ViewportSpace;
@@ -51,6 +63,7 @@ namespace yap
 
         std::shared_ptr<Box> m_Viewport;
         std::shared_ptr<Box> m_ViewportPreview;
+        uint64_t m_ViewportRevision = 0;
         std::shared_ptr<Box> m_ViewportOverlay;
 
         std::shared_ptr<Box> m_ToolBar;
@@ -87,6 +100,11 @@ namespace yap
 
             m_ViewportSpace = std::make_shared<ViewportSpace>(m_Project, m_ViewportPreview);
 
+            m_Project->OnLayerLoadFailed = [](Project& project, std::shared_ptr<Layer> layer, const std::string& error)
+            {
+                std::printf("Unable to load layer %d: %s. It is shown empty and the project cannot be saved over its file.\n", layer->GetId(), error.c_str());
+            };
+
             InitHeader();
             InitToolBar();
             InitArea();
@@ -162,7 +180,9 @@ namespace yap
 
                     if (layer)
                     {
+                        m_Project->GetHistory().Begin(layer);
                         layer->FlipHorizontally();
+                        m_Project->GetHistory().Commit();
                     }
                 }
             );
@@ -175,7 +195,9 @@ namespace yap
 
                     if (layer)
                     {
+                        m_Project->GetHistory().Begin(layer);
                         layer->FlipVertically();
+                        m_Project->GetHistory().Commit();
                     }
                 }
             );
@@ -246,16 +268,64 @@ namespace yap
                     .WithSize(AxisSizingRule::Fill(), AxisSizingRule::Fill())
             );
 
+            OnKeyboardDown = [this](Element& element, KeyboardKey key)
+            {
+                if (key == ProfileKey)
+                {
+                    ToggleProfiling();
+                    return;
+                }
+
+                // Modals work on their own copy of the state, so the history is left alone while one is open.
+                if (!m_ModalContent->GetChildren().empty())
+                {
+                    return;
+                }
+
+                const Keyboard& keyboard = element.GetScreen()->GetKeyboard();
+
+                if (key == UndoKey && !keyboard.IsModifierEnabled(KeyboardModifier::Shift))
+                {
+                    m_Project->GetHistory().Undo();
+                }
+                else if (key == UndoKey || key == RedoKey)
+                {
+                    m_Project->GetHistory().Redo();
+                }
+            };
+
             AddChild(m_MainContent);
             AddChild(m_ModalContent);
         }
 
+        const std::shared_ptr<Project>& GetProject() const
+        {
+            return m_Project;
+        }
+
         void Animate() override
         {
             Box::Animate();
 
+            // A layer that arrives while compositing is only picked up by the next one, and compositing may
+            // queue layers of its own, so loading is checked on both sides.
+            bool loading = m_Project->IsLoading();
+
             std::shared_ptr<const Bitmap> projection = m_Project->RenderCanvas();
 
+            if (loading || m_Project->IsLoading())
+            {
+                GetScreen()->RequestFrameAfter(LoadingRefreshInterval);
+            }
+
+            // Nothing to restyle while the canvas is unchanged.
+            if (projection->GetRevision() == m_ViewportRevision)
+            {
+                return;
+            }
+
+            m_ViewportRevision = projection->GetRevision();
+
             m_ViewportPreview->SetStyle(
                 m_ViewportPreview->GetStyle()
                     .WithSize(AxisSizingRule::Fixed(projection->GetWidth()), AxisSizingRule::Fixed(projection->GetHeight()))
@@ -266,6 +336,14 @@ namespace yap
     private:
         void InitHeader()
         {
+            m_MainHeaderTitle->SetStyle(
+                StyleSheet()
+                    .WithSize(AxisSizingRule::Fit(), AxisSizingRule::Fill())
+                    .WithAlignment(BoxAxisAlignment::Start, BoxAxisAlignment::Center)
+                    .WithPadding(BoxPadding(8))
+            );
+
+            m_MainHeaderTitle->AddChild(std::make_shared<PerformanceOverlay>());
 
             m_MainHeaderActions->SetStyle(
                 StyleSheet()
@@ -477,5 +555,33 @@ namespace yap
 
             m_ToolBarActions->AddChild(button);
         }
+
+        /**
+         * @brief Starts a profiler capture, or stops the running one and writes it as a Chrome trace.
+         */
+        void ToggleProfiling()
+        {
+            Profiler& profiler = Profiler::Get();
+
+            if (!profiler.IsEnabled())
+            {
+                profiler.Start();
+                std::printf("Profiling started; press Ctrl+P again to save the trace.\n");
+
+                return;
+            }
+
+            profiler.Stop();
+
+            try
+            {
+                profiler.ExportChromeTrace(TracePath);
+                std::printf("Profiler trace saved to %s\n", TracePath);
+            }
+            catch (const std::exception& e)
+            {
+                std::printf("Unable to save the profiler trace: %s\n", e.what());
+            }
+        }
     };
 }
\ No newline at end of file
@@ -140,6 +140,48 @@ void CV::text(float x, float y, const char *t)
     }
 }
 
+//glDrawPixels descarta a imagem inteira quando a posicao raster fica fora da janela.
+//Por isso a posicao e definida na origem e deslocada com glBitmap, que aceita deslocamentos
+//para fora da janela.
+void CV::image(float x, float y, int width, int height, const unsigned char *pixels)
+{
+   if (width <= 0 || height <= 0)
+   {
+      return;
+   }
+
+   glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+   glRasterPos2i(0, 0);
+#if Y_CANVAS_CRESCE_PARA_CIMA == TRUE
+   glBitmap(0, 0, 0, 0, x, y + height, NULL);
+#else
+   glBitmap(0, 0, 0, 0, x, -y, NULL);
+#endif
+   glPixelZoom(1.0f, -1.0f);
+   glDrawPixels(width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+   glPixelZoom(1.0f, 1.0f);
+}
+
+void CV::triangles(const float *vertices, int count)
+{
+   if (count <= 0)
+   {
+      return;
+   }
+
+   const GLsizei stride = 5 * sizeof(float);
+
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_COLOR_ARRAY);
+
+   glVertexPointer(2, GL_FLOAT, stride, vertices);
+   glColorPointer(3, GL_FLOAT, stride, vertices + 2);
+   glDrawArrays(GL_TRIANGLES, 0, count);
+
+   glDisableClientState(GL_COLOR_ARRAY);
+   glDisableClientState(GL_VERTEX_ARRAY);
+}
+
 void CV::clear(float r, float g, float b)
 {
    glClearColor( r, g, b, 1 );
@@ -51,6 +51,14 @@ public:
 
     static void clear(float r, float g, float b);
 
+    //desenha uma imagem RGBA de 8 bits por canal com o canto superior esquerdo na coordenada (x,y).
+    //as linhas de pixels devem estar armazenadas de cima para baixo.
+    static void image(float x, float y, int width, int height, const unsigned char *pixels);
+
+    //desenha `count` vertices como triangulos (GL_TRIANGLES) em uma unica chamada. Cada vertice tem
+    //x, y, r, g, b intercalados, e a cor atual fica indefinida depois da chamada.
+    static void triangles(const float *vertices, int count);
+
     //desenha texto na coordenada (x,y)
     static void text(float x, float y, const char *t);
     // static void text(Vector2 pos, const char *t);  //varias funcoes ainda nao tem implementacao. Faca como exercicio
@@ -25,6 +25,7 @@
 #include "gl_canvas2d.h"
 
 #include "Benchmark.h"
+#include "Profiler.h"
 
 #include "BMP.h"
 #include "Bitmap.h"
@@ -90,54 +91,58 @@ std::shared_ptr<yap::Screen> screen;
 yap::RenderingContext renderingContext;
 yap::RenderingEngine renderingEngine;
 
-std::shared_ptr<yap::Benchmark> frameBenchmark;
-std::shared_ptr<yap::Benchmark> processBenchmark;
-std::shared_ptr<yap::Benchmark> renderBenchmark;
-
 int windowWidth = 1280;
 int windowHeight = 720;
 
+// How often the screen is polled for frames requested from other threads or for later.
+const int FramePollInterval = 16;
+
+// Frames are drawn on demand instead of on every idle iteration of GLUT, so a window that is left alone
+// keeps presenting its last frame without using the CPU.
+void redisplayIfRequested()
+{
+   if (screen->IsFrameRequested())
+   {
+      glutPostRedisplay();
+   }
+}
+
+void poll(int value)
+{
+   redisplayIfRequested();
+   glutTimerFunc(FramePollInterval, poll, 0);
+}
+
 void render()
 {
-   frameBenchmark->Stop();
-   frameBenchmark->Start();
+   yap::ProfileScope frameScope("Frame");
 
    renderingContext.ClearCommands();
 
-   renderBenchmark->Start();
    screen->Resize(windowWidth, windowHeight);
    screen->Render(renderingContext);
-   renderBenchmark->Stop();
 
-   processBenchmark->Start();
+   yap::Benchmark& executeBenchmark = screen->GetExecuteBenchmark();
+
+   executeBenchmark.Start();
    renderingEngine.ExecuteCommands(renderingContext.GetCommands());
-   processBenchmark->Stop();
+   executeBenchmark.Stop();
 
-   if (frameBenchmark->GetSamples() % 100 == 0)
-   {
-      printf(
-         "FPS: %.2lf (Render: %.2lfms, Execute: %.2lfms)\n",
-         1.0 / frameBenchmark->GetAverageTime(),
-         renderBenchmark->GetAverageTime() * 1000.0,
-         processBenchmark->GetAverageTime() * 1000.0
-      );
-
-      frameBenchmark->Reset();
-      renderBenchmark->Reset();
-      processBenchmark->Reset();
-   }
+   redisplayIfRequested();
 }
 
 void keyboard(int key)
 {
    // printf("\nTecla: %d" , key);
    screen->ProcessKeyboardDown(key);
+   redisplayIfRequested();
 }
 
 void keyboardUp(int key)
 {
    // printf("\nLiberou: %d" , key);
    screen->ProcessKeyboardUp(key);
+   redisplayIfRequested();
 }
 
 void mouse(int button, int state, int wheel, int direction, int x, int y)
@@ -163,19 +168,22 @@ void mouse(int button, int state, int wheel, int direction, int x, int y)
    {
       screen->ProcessMouseScroll((yap::MouseScrollDirection)direction);
    }
+
+   redisplayIfRequested();
 }
 
 int main(void)
 {
-   screen = std::make_shared<yap::Screen>();
+   yap::Profiler::Get().SetThreadName("Main");
 
-   frameBenchmark = std::make_shared<yap::Benchmark>();
-   processBenchmark = std::make_shared<yap::Benchmark>();
-   renderBenchmark = std::make_shared<yap::Benchmark>();
+   screen = std::make_shared<yap::Screen>();
 
    screen->Init();
    screen->Root->AddChild(std::make_shared<yap::Workspace>());
 
    CV::init(&windowWidth, &windowHeight, "YAP - Yet Another Paint (Jaime Antonio Daniel Filho)");
+
+   glutIdleFunc(nullptr);
+   glutTimerFunc(0, poll, 0);
    CV::run();
 }
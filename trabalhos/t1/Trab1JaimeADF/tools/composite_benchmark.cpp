@@ -0,0 +1,201 @@
+// Microbenchmark for the span compositing kernels in Composite.h.
+//
+// Compares the per-pixel ColorRGBA::CompositeOver call used before the kernels existed against every
+// kernel supported by the running CPU, for both float and 8-bit rows. Before timing a kernel, its output
+// is checked against the scalar kernel on the same inputs, including spans too short for a full vector;
+// a kernel that differs by more than 1 (in 8-bit steps) in any channel is reported and makes the
+// benchmark exit with an error instead of showing up as a speedup.
+//
+// Usage: composite_benchmark [row width] [rows]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../src/Benchmark.h"
+#include "../src/Composite.h"
+
+namespace
+{
+    template <typename Pixel, typename Kernel>
+    double Measure(const std::vector<Pixel>& source, const std::vector<Pixel>& destination, int width, int rows, Kernel kernel)
+    {
+        std::vector<Pixel> row(destination);
+
+        yap::Benchmark benchmark;
+
+        for (int repetition = 0; repetition < 5; ++repetition)
+        {
+            benchmark.Start();
+
+            for (int y = 0; y < rows; ++y)
+            {
+                kernel(source.data(), row.data(), width);
+            }
+
+            benchmark.Stop();
+        }
+
+        return benchmark.GetAverageTime() * 1000.0;
+    }
+
+    // Channel differences are measured in 8-bit steps for both pixel formats.
+    const float Tolerance = 1.0f;
+
+    float GetMaxDifference(const yap::ColorRGBA& a, const yap::ColorRGBA& b)
+    {
+        return 255.0f * std::max(std::max(std::fabs(a.R - b.R), std::fabs(a.G - b.G)), std::max(std::fabs(a.B - b.B), std::fabs(a.A - b.A)));
+    }
+
+    float GetMaxDifference(const yap::ColorRGBA8& a, const yap::ColorRGBA8& b)
+    {
+        return static_cast<float>(std::max(
+            std::max(std::abs(a.R - b.R), std::abs(a.G - b.G)),
+            std::max(std::abs(a.B - b.B), std::abs(a.A - b.A))
+        ));
+    }
+
+    /**
+     * Composites the first `count` pixels with `kernel` and with the scalar kernel and returns the number of
+     * pixels of the row that differ by more than the tolerance, so a kernel that writes past `count` is
+     * caught too. Leaves the scalar kernel selected.
+     */
+    template <typename Pixel>
+    int CountMismatches(const std::vector<Pixel>& source, const std::vector<Pixel>& destination, int count, yap::CompositeKernel kernel)
+    {
+        std::vector<Pixel> expected(destination);
+        std::vector<Pixel> actual(destination);
+
+        yap::Composite::SetKernel(kernel);
+        yap::Composite::SourceOver(source.data(), actual.data(), count);
+
+        yap::Composite::SetKernel(yap::CompositeKernel::Scalar);
+        yap::Composite::SourceOver(source.data(), expected.data(), count);
+
+        int mismatches = 0;
+
+        for (size_t x = 0; x < expected.size(); ++x)
+        {
+            if (GetMaxDifference(expected[x], actual[x]) > Tolerance)
+            {
+                mismatches++;
+            }
+        }
+
+        return mismatches;
+    }
+
+    /**
+     * Checks a kernel over the whole row and over every span length up to a few vectors, which exercises
+     * the remainder loops. Prints the first failure and returns whether the kernel matched everywhere.
+     */
+    template <typename Pixel>
+    bool Verify(const std::vector<Pixel>& source, const std::vector<Pixel>& destination, yap::CompositeKernel kernel, const char* format)
+    {
+        int width = static_cast<int>(source.size());
+
+        std::vector<int> counts;
+
+        for (int count = 1; count < std::min(width, 32); ++count)
+        {
+            counts.push_back(count);
+        }
+
+        counts.push_back(width);
+
+        for (int count : counts)
+        {
+            int mismatches = CountMismatches(source, destination, count, kernel);
+
+            if (mismatches > 0)
+            {
+                std::printf("%-24s MISMATCH: %d pixels differ from Scalar in a span of %d\n", (std::string(yap::Composite::GetKernelName(kernel)) + " (" + format + ")").c_str(), mismatches, count);
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int width = argc > 1 ? std::atoi(argv[1]) : 1920;
+    int rows = argc > 2 ? std::atoi(argv[2]) : 4000;
+
+    std::vector<yap::ColorRGBA8> source8(width);
+    std::vector<yap::ColorRGBA8> destination8(width);
+
+    std::vector<yap::ColorRGBA> sourceF32(width);
+    std::vector<yap::ColorRGBA> destinationF32(width);
+
+    std::srand(4410);
+
+    for (int x = 0; x < width; ++x)
+    {
+        source8[x] = yap::ColorRGBA8(std::rand() % 256, std::rand() % 256, std::rand() % 256, std::rand() % 256);
+        destination8[x] = yap::ColorRGBA8(std::rand() % 256, std::rand() % 256, std::rand() % 256, std::rand() % 256);
+
+        sourceF32[x] = source8[x].ToRGBA();
+        destinationF32[x] = destination8[x].ToRGBA();
+    }
+
+    std::printf("%d rows of %d pixels\n\n", rows, width);
+    std::printf("%-24s %12s %12s\n", "Kernel", "Time (ms)", "Mpixels/s");
+
+    double pixels = static_cast<double>(width) * rows / 1e6;
+
+    double baseline = Measure(sourceF32, destinationF32, width, rows, [](const yap::ColorRGBA* s, yap::ColorRGBA* d, int count) {
+        for (int i = 0; i < count; ++i)
+        {
+            d[i] = s[i].CompositeOver(d[i]);
+        }
+    });
+
+    std::printf("%-24s %12.2f %12.1f\n", "CompositeOver (F32)", baseline, pixels / (baseline / 1000.0));
+
+    const yap::CompositeKernel kernels[] = {
+        yap::CompositeKernel::Scalar,
+        yap::CompositeKernel::SSE2,
+        yap::CompositeKernel::AVX2
+    };
+
+    bool matched = true;
+
+    for (auto kernel : kernels)
+    {
+        if (!yap::Composite::IsSupported(kernel))
+        {
+            continue;
+        }
+
+        bool matchedF32 = Verify(sourceF32, destinationF32, kernel, "F32");
+        bool matched8 = Verify(source8, destination8, kernel, "RGBA8");
+
+        if (!matchedF32 || !matched8)
+        {
+            matched = false;
+            continue;
+        }
+
+        yap::Composite::SetKernel(kernel);
+
+        double timeF32 = Measure(sourceF32, destinationF32, width, rows, [](const yap::ColorRGBA* s, yap::ColorRGBA* d, int count) {
+            yap::Composite::SourceOver(s, d, count);
+        });
+
+        double time8 = Measure(source8, destination8, width, rows, [](const yap::ColorRGBA8* s, yap::ColorRGBA8* d, int count) {
+            yap::Composite::SourceOver(s, d, count);
+        });
+
+        std::string name = yap::Composite::GetKernelName(kernel);
+
+        std::printf("%-24s %12.2f %12.1f  (%.2fx)\n", (name + " (F32)").c_str(), timeF32, pixels / (timeF32 / 1000.0), baseline / timeF32);
+        std::printf("%-24s %12.2f %12.1f  (%.2fx)\n", (name + " (RGBA8)").c_str(), time8, pixels / (time8 / 1000.0), baseline / time8);
+    }
+
+    return matched ? 0 : 1;
+}
@@ -0,0 +1,530 @@
+// Headless batch processor: applies a chain of transforms and effects to BMP images and .yap projects
+// without opening a window, processing several files at once.
+//
+// Every input is opened as a project (a BMP becomes a project of its size with a single layer), each step
+// of the chain is applied to every layer in order, and the result is written to the output directory with
+// the same name and the extension of the output format.
+//
+// Usage: yap_batch [options] <input>...
+//
+//   -c <chain>    Comma-separated steps, applied in order (see below).
+//   -o <dir>      Output directory (required; must exist).
+//   -f <format>   bmp (24 bits), bmp32 (with alpha) or yap. Defaults to the format of each input.
+//   -j <count>    Number of files processed at once. Defaults to the number of cores.
+//
+// Steps take their arguments after '=', separated by ':':
+//
+//   flip-h, flip-v             Mirror every layer in place.
+//   scale=<w>x<h>[:bilinear]   Resize the canvas, scaling the layers and their positions with it.
+//   scale=<percent>%[:bilinear]
+//   rotate=<degrees>           Rotate every layer around the center of the canvas.
+//   brightness=<-1..1>, contrast=<-1..1>, gamma=<0..10>, grayscale, sepia,
+//   blur=<radius>, pixelate=<block size>, noise=<amount>[:<alpha amount>]
+//
+// Example: yap_batch -c "scale=50%:bilinear,grayscale,blur=2" -f bmp -o out images/*.bmp
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/BMP.h"
+#include "../src/Benchmark.h"
+#include "../src/Effects.h"
+#include "../src/Path.h"
+#include "../src/Project.h"
+#include "../src/ThreadPool.h"
+
+namespace
+{
+    using Operation = std::function<void(yap::Project&)>;
+
+    enum class OutputFormat
+    {
+        SameAsInput,
+        BMP24,
+        BMP32,
+        YAP
+    };
+
+    std::vector<std::string> Split(const std::string& text, char delimiter)
+    {
+        std::vector<std::string> parts;
+        std::stringstream ss(text);
+        std::string part;
+
+        while (std::getline(ss, part, delimiter))
+        {
+            parts.push_back(part);
+        }
+
+        return parts;
+    }
+
+    float ParseFloat(const std::string& text)
+    {
+        char* end = nullptr;
+        float value = std::strtof(text.c_str(), &end);
+
+        if (text.empty() || *end != '\0')
+        {
+            throw std::runtime_error("Invalid number '" + text + "'");
+        }
+
+        return value;
+    }
+
+    /**
+     * Effects keep scratch buffers between calls, so every application creates its own instance instead of
+     * sharing one between the files being processed at once.
+     */
+    Operation ApplyEffect(std::function<std::shared_ptr<yap::Effect>()> createEffect)
+    {
+        return [createEffect](yap::Project& project) {
+            std::shared_ptr<yap::Effect> effect = createEffect();
+
+            for (const auto& layer : project.GetLayers())
+            {
+                yap::Bitmap result;
+                effect->Apply(*layer->GetBitmap(), result);
+
+                layer->SetBitmap(result);
+            }
+        };
+    }
+
+    Operation Scale(int width, int height, yap::ScalingMethod method)
+    {
+        if (width <= 0 || height <= 0)
+        {
+            throw std::runtime_error("Scale size must be positive");
+        }
+
+        return [width, height, method](yap::Project& project) {
+            float xRatio = static_cast<float>(width) / project.GetWidth();
+            float yRatio = static_cast<float>(height) / project.GetHeight();
+
+            for (const auto& layer : project.GetLayers())
+            {
+                yap::Vec2 position = layer->GetPosition();
+                yap::Vec2 size = layer->GetSize();
+
+                layer->Scale(
+                    std::max(1.0f, std::round(size.X * xRatio)),
+                    std::max(1.0f, std::round(size.Y * yRatio)),
+                    method
+                );
+
+                layer->SetPosition(yap::Vec2(std::round(position.X * xRatio), std::round(position.Y * yRatio)));
+            }
+
+            project.SetSize(width, height);
+        };
+    }
+
+    Operation ParseStep(const std::string& step)
+    {
+        size_t separator = step.find('=');
+
+        std::string name = step.substr(0, separator);
+        std::vector<std::string> arguments = separator == std::string::npos ? std::vector<std::string>() : Split(step.substr(separator + 1), ':');
+
+        auto expectArguments = [&](size_t minimum, size_t maximum) {
+            if (arguments.size() < minimum || arguments.size() > maximum)
+            {
+                throw std::runtime_error("Wrong number of arguments for '" + name + "'");
+            }
+        };
+
+        if (name == "flip-h" || name == "flip-v")
+        {
+            expectArguments(0, 0);
+
+            bool horizontal = name == "flip-h";
+
+            return [horizontal](yap::Project& project) {
+                for (const auto& layer : project.GetLayers())
+                {
+                    if (horizontal)
+                    {
+                        layer->FlipHorizontally();
+                    }
+                    else
+                    {
+                        layer->FlipVertically();
+                    }
+                }
+            };
+        }
+
+        if (name == "scale")
+        {
+            expectArguments(1, 2);
+
+            yap::ScalingMethod method = yap::ScalingMethod::NearestNeighbor;
+
+            if (arguments.size() == 2)
+            {
+                if (arguments[1] != "bilinear")
+                {
+                    throw std::runtime_error("Unknown scaling method '" + arguments[1] + "'");
+                }
+
+                method = yap::ScalingMethod::Bilinear;
+            }
+
+            const std::string& size = arguments[0];
+
+            if (!size.empty() && size.back() == '%')
+            {
+                float factor = ParseFloat(size.substr(0, size.size() - 1)) / 100.0f;
+
+                if (factor <= 0.0f)
+                {
+                    throw std::runtime_error("Scale size must be positive");
+                }
+
+                return [factor, method](yap::Project& project) {
+                    Scale(
+                        std::max(1, static_cast<int>(std::round(project.GetWidth() * factor))),
+                        std::max(1, static_cast<int>(std::round(project.GetHeight() * factor))),
+                        method
+                    )(project);
+                };
+            }
+
+            std::vector<std::string> dimensions = Split(size, 'x');
+
+            if (dimensions.size() != 2)
+            {
+                throw std::runtime_error("Invalid size '" + size + "', expected <width>x<height> or <percent>%");
+            }
+
+            return Scale(static_cast<int>(ParseFloat(dimensions[0])), static_cast<int>(ParseFloat(dimensions[1])), method);
+        }
+
+        if (name == "rotate")
+        {
+            expectArguments(1, 1);
+
+            float radians = ParseFloat(arguments[0]) * std::acos(-1.0f) / 180.0f;
+
+            return [radians](yap::Project& project) {
+                yap::Vec2 pivot(project.GetWidth() / 2.0f, project.GetHeight() / 2.0f);
+
+                for (const auto& layer : project.GetLayers())
+                {
+                    layer->Rotate(radians, pivot);
+                }
+            };
+        }
+
+        if (name == "brightness" || name == "contrast")
+        {
+            expectArguments(1, 1);
+
+            float value = ParseFloat(arguments[0]);
+            bool brightness = name == "brightness";
+
+            return ApplyEffect([value, brightness]() {
+                auto effect = std::make_shared<yap::BrightnessContrastEffect>();
+
+                if (brightness)
+                {
+                    effect->SetBrightness(value);
+                }
+                else
+                {
+                    effect->SetContrast(value);
+                }
+
+                return effect;
+            });
+        }
+
+        if (name == "gamma")
+        {
+            expectArguments(1, 1);
+
+            float gamma = ParseFloat(arguments[0]);
+
+            return ApplyEffect([gamma]() {
+                auto effect = std::make_shared<yap::GammaCorrectionEffect>();
+                effect->SetGamma(gamma);
+
+                return effect;
+            });
+        }
+
+        if (name == "grayscale")
+        {
+            expectArguments(0, 0);
+
+            return ApplyEffect([]() { return std::make_shared<yap::GrayscaleEffect>(); });
+        }
+
+        if (name == "sepia")
+        {
+            expectArguments(0, 0);
+
+            return ApplyEffect([]() { return std::make_shared<yap::SepiaEffect>(); });
+        }
+
+        if (name == "blur")
+        {
+            expectArguments(1, 1);
+
+            float radius = ParseFloat(arguments[0]);
+
+            return ApplyEffect([radius]() {
+                auto effect = std::make_shared<yap::GaussianBlurEffect>();
+                effect->SetRadius(radius);
+
+                return effect;
+            });
+        }
+
+        if (name == "pixelate")
+        {
+            expectArguments(1, 1);
+
+            int blockSize = static_cast<int>(ParseFloat(arguments[0]));
+
+            if (blockSize < 1)
+            {
+                throw std::runtime_error("Block size must be at least 1");
+            }
+
+            return ApplyEffect([blockSize]() {
+                auto effect = std::make_shared<yap::PixelateEffect>();
+                effect->SetBlockSize(blockSize);
+
+                return effect;
+            });
+        }
+
+        if (name == "noise")
+        {
+            expectArguments(1, 2);
+
+            float amount = ParseFloat(arguments[0]);
+            float alphaAmount = arguments.size() > 1 ? ParseFloat(arguments[1]) : 0.0f;
+
+            return ApplyEffect([amount, alphaAmount]() {
+                auto effect = std::make_shared<yap::RandomNoiseEffect>();
+                effect->SetNoise(amount, amount, amount, alphaAmount);
+
+                return effect;
+            });
+        }
+
+        throw std::runtime_error("Unknown step '" + name + "'");
+    }
+
+    std::string ToLower(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+
+    /**
+     * Opens, transforms and writes a single file, returning the path that was written.
+     */
+    std::string ProcessFile(const std::string& input, const std::vector<Operation>& chain, const std::string& outputDirectory, OutputFormat format)
+    {
+        std::string name = yap::Path::BaseName(input);
+        std::string extension = ToLower(yap::Path::Extension(name));
+        std::string stem = extension.empty() ? name : name.substr(0, name.size() - extension.size() - 1);
+
+        std::shared_ptr<yap::Project> project;
+
+        if (extension == "bmp")
+        {
+            yap::Bitmap bitmap = yap::BMP::Load(input);
+
+            project = std::make_shared<yap::Project>(bitmap.GetWidth(), bitmap.GetHeight());
+            project->CreateLayer(bitmap);
+        }
+        else if (extension == "yap")
+        {
+            project = std::make_shared<yap::Project>(0, 0);
+            project->Load(input);
+        }
+        else
+        {
+            throw std::runtime_error("Unsupported input format");
+        }
+
+        if (format == OutputFormat::SameAsInput)
+        {
+            format = extension == "bmp" ? OutputFormat::BMP24 : OutputFormat::YAP;
+        }
+
+        for (const auto& operation : chain)
+        {
+            operation(*project);
+        }
+
+        std::string output = outputDirectory + "/" + stem + (format == OutputFormat::YAP ? ".yap" : ".bmp");
+
+        if (format == OutputFormat::YAP)
+        {
+            project->Save(output);
+        }
+        else
+        {
+            // Layers of a version 2 project are still decoding in the background, so wait for all of them.
+            yap::BMP::Save(output, *project->RenderCanvas(true), format == OutputFormat::BMP32);
+        }
+
+        return output;
+    }
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "Usage: yap_batch [-c <chain>] -o <dir> [-f bmp|bmp32|yap] [-j <count>] <input>...\n"
+            "\n"
+            "Steps (comma-separated, arguments after '=' separated by ':'):\n"
+            "  flip-h, flip-v, scale=<w>x<h>[:bilinear], scale=<percent>%%[:bilinear], rotate=<degrees>,\n"
+            "  brightness=<v>, contrast=<v>, gamma=<v>, grayscale, sepia, blur=<radius>,\n"
+            "  pixelate=<block size>, noise=<amount>[:<alpha amount>]\n"
+        );
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<Operation> chain;
+    std::vector<std::string> inputs;
+
+    std::string outputDirectory;
+    OutputFormat format = OutputFormat::SameAsInput;
+    int jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+
+            if (argument == "-h" || argument == "--help")
+            {
+                PrintUsage();
+                return 0;
+            }
+
+            if (argument == "-c" || argument == "-o" || argument == "-f" || argument == "-j")
+            {
+                if (i + 1 >= argc)
+                {
+                    throw std::runtime_error("Missing value for " + argument);
+                }
+
+                std::string value = argv[++i];
+
+                if (argument == "-c")
+                {
+                    for (const auto& step : Split(value, ','))
+                    {
+                        if (!step.empty())
+                        {
+                            chain.push_back(ParseStep(step));
+                        }
+                    }
+                }
+                else if (argument == "-o")
+                {
+                    outputDirectory = value;
+                }
+                else if (argument == "-f")
+                {
+                    if (value == "bmp")
+                    {
+                        format = OutputFormat::BMP24;
+                    }
+                    else if (value == "bmp32")
+                    {
+                        format = OutputFormat::BMP32;
+                    }
+                    else if (value == "yap")
+                    {
+                        format = OutputFormat::YAP;
+                    }
+                    else
+                    {
+                        throw std::runtime_error("Unknown output format '" + value + "'");
+                    }
+                }
+                else
+                {
+                    jobs = std::max(1, static_cast<int>(ParseFloat(value)));
+                }
+            }
+            else if (!argument.empty() && argument[0] == '-')
+            {
+                throw std::runtime_error("Unknown option " + argument);
+            }
+            else
+            {
+                inputs.push_back(argument);
+            }
+        }
+
+        if (outputDirectory.empty() || inputs.empty())
+        {
+            throw std::runtime_error("An output directory and at least one input are required");
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "yap_batch: %s\n\n", e.what());
+        PrintUsage();
+        return 2;
+    }
+
+    // Files are spread over a pool of their own; the work inside each file (effects, compositing, chunk
+    // compression) still goes to the shared pool, whose ParallelFor is safe to nest.
+    yap::ThreadPool files(static_cast<size_t>(jobs - 1));
+
+    std::mutex outputMutex;
+    int failures = 0;
+
+    yap::Benchmark benchmark;
+    benchmark.Start();
+
+    files.ParallelFor(static_cast<int>(inputs.size()), [&](int index) {
+        const std::string& input = inputs[index];
+
+        try
+        {
+            std::string output = ProcessFile(input, chain, outputDirectory, format);
+
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::printf("%s -> %s\n", input.c_str(), output.c_str());
+        }
+        catch (const std::exception& e)
+        {
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::fprintf(stderr, "%s: %s\n", input.c_str(), e.what());
+
+            failures++;
+        }
+    });
+
+    benchmark.Stop();
+
+    std::printf("%d of %d files processed in %.2f s\n", static_cast<int>(inputs.size()) - failures, static_cast<int>(inputs.size()), benchmark.GetTotalTime());
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,191 @@
+// End-to-end test of yap_batch: writes a layered project in the version 2 format, exports it to BMP with
+// yap_batch, and checks the exported pixels against the canvas composited in memory.
+//
+// Version 2 projects are loaded lazily, so this catches exports that run before the layers are decoded
+// and come out blank or with layers missing.
+//
+// Usage: yap_batch_test [<path to yap_batch>]
+//
+// Defaults to ./yap_batch. Temporary files are written to the current folder and removed at the end.
+// Exits with 0 when every export matches.
+//
+// Example: yap_batch_test ./yap_batch
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#include "../src/BMP.h"
+#include "../src/Bitmap.h"
+#include "../src/Project.h"
+
+namespace
+{
+    const char* TemporaryYAP = "yap_batch_test.tmp.yap";
+    const char* TemporaryBMP = "yap_batch_test.tmp.bmp";
+    const char* ReferenceBMP = "yap_batch_test.ref.bmp";
+
+    const int Width = 320;
+    const int Height = 240;
+
+    // The loader races the export, so a single run could pass by luck.
+    const int Runs = 4;
+
+    /**
+     * Builds a project with an opaque background, a translucent layer partially off the canvas, and a hidden
+     * layer that must not show up in the export.
+     */
+    void CreateProject(yap::Project& project)
+    {
+        auto background = project.CreateLayer();
+
+        for (int y = 0; y < Height; ++y)
+        {
+            for (int x = 0; x < Width; ++x)
+            {
+                background->SetPixel(x, y, yap::ColorRGBA(x / static_cast<float>(Width), y / static_cast<float>(Height), 0.25f, 1.0f));
+            }
+        }
+
+        auto overlay = project.CreateLayer(yap::Bitmap(200, 150));
+        overlay->SetPosition(yap::Vec2(180, 120));
+
+        for (int y = 0; y < 150; ++y)
+        {
+            for (int x = 0; x < 200; ++x)
+            {
+                overlay->SetPixel(180 + x, 120 + y, yap::ColorRGBA(0.0f, 0.0f, 1.0f, (x % 32) / 31.0f));
+            }
+        }
+
+        auto hidden = project.CreateLayer();
+        hidden->SetVisible(false);
+
+        for (int y = 0; y < Height; ++y)
+        {
+            for (int x = 0; x < Width; ++x)
+            {
+                hidden->SetPixel(x, y, yap::ColorRGBA(1.0f, 1.0f, 1.0f, 1.0f));
+            }
+        }
+    }
+
+    /**
+     * Returns the number of pixels that differ between two BMPs, or -1 when their sizes differ.
+     */
+    int CountDifferences(const yap::Bitmap& expected, const yap::Bitmap& actual)
+    {
+        if (expected.GetWidth() != actual.GetWidth() || expected.GetHeight() != actual.GetHeight())
+        {
+            return -1;
+        }
+
+        int differences = 0;
+
+        for (int y = 0; y < expected.GetHeight(); ++y)
+        {
+            for (int x = 0; x < expected.GetWidth(); ++x)
+            {
+                if (yap::ColorRGBA8(expected.GetPixel(x, y)) != yap::ColorRGBA8(actual.GetPixel(x, y)))
+                {
+                    differences++;
+                }
+            }
+        }
+
+        return differences;
+    }
+
+    int CountLitPixels(const yap::Bitmap& bitmap)
+    {
+        int lit = 0;
+
+        for (int y = 0; y < bitmap.GetHeight(); ++y)
+        {
+            for (int x = 0; x < bitmap.GetWidth(); ++x)
+            {
+                yap::ColorRGBA8 pixel(bitmap.GetPixel(x, y));
+
+                if (pixel.R != 0 || pixel.G != 0 || pixel.B != 0)
+                {
+                    lit++;
+                }
+            }
+        }
+
+        return lit;
+    }
+
+    /**
+     * Exports the temporary project with yap_batch in the given format and compares the result with the
+     * reference written from memory. Returns whether they match.
+     */
+    bool CheckExport(const std::string& batch, const std::string& format, const yap::Bitmap& canvas)
+    {
+        bool withAlpha = format == "bmp32";
+
+        yap::BMP::Save(ReferenceBMP, canvas, withAlpha);
+
+        std::string command = "\"" + batch + "\" -f " + format + " -o . " + TemporaryYAP;
+
+        std::fflush(stdout);
+
+        if (std::system(command.c_str()) != 0)
+        {
+            std::fprintf(stderr, "FAIL %s: yap_batch failed\n", format.c_str());
+            return false;
+        }
+
+        yap::Bitmap expected = yap::BMP::Load(ReferenceBMP);
+        yap::Bitmap actual = yap::BMP::Load(TemporaryBMP);
+
+        int differences = CountDifferences(expected, actual);
+        int lit = CountLitPixels(actual);
+
+        if (differences != 0 || lit == 0)
+        {
+            std::fprintf(stderr, "FAIL %s: %d differing pixels, %d lit pixels of %d\n", format.c_str(), differences, lit, CountLitPixels(expected));
+            return false;
+        }
+
+        std::printf("ok %s: %d lit pixels\n", format.c_str(), lit);
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string batch = argc > 1 ? argv[1] : "./yap_batch";
+
+    bool passed = true;
+
+    try
+    {
+        yap::Project project(Width, Height);
+        CreateProject(project);
+
+        project.Save(TemporaryYAP);
+
+        yap::Bitmap canvas = *project.RenderCanvas();
+
+        for (int run = 0; run < Runs; ++run)
+        {
+            passed = CheckExport(batch, "bmp", canvas) && passed;
+            passed = CheckExport(batch, "bmp32", canvas) && passed;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "yap_batch_test: %s\n", e.what());
+        passed = false;
+    }
+
+    std::remove(TemporaryYAP);
+    std::remove(TemporaryBMP);
+    std::remove(ReferenceBMP);
+
+    std::printf("%s\n", passed ? "PASS" : "FAIL");
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,552 @@
+// Benchmark suite for the image kernels and the frame pipeline, reporting JSON for regression tracking.
+//
+// Every case is run a number of warmup iterations that are discarded, then timed once per iteration.
+// Work that only prepares an iteration (restoring a layer that a fill painted over, invalidating the
+// canvas) is kept out of the timing. The report lists, for every case and size, the minimum, mean,
+// standard deviation, 50th, 90th and 99th percentiles and maximum, in milliseconds.
+//
+// Usage: yap_benchmark [options]
+//
+//   -s <w>x<h>     Image size; may be repeated. Defaults to 640x480 and 1920x1080.
+//   -n <count>     Timed iterations per case (default 10).
+//   -w <count>     Warmup iterations per case (default 2).
+//   -l <count>     Layers in the compositing and project file cases (default 8).
+//   -f <text>      Only run the cases whose name contains the text.
+//   -o <file>      Write the JSON report to a file instead of the standard output.
+//
+// The screen cases build the whole workspace and load its icons from Trab1JaimeADF/assets, so run the
+// benchmark from the folder that contains Trab1JaimeADF, like the editor. The render cases record the
+// frame into a RenderingContext without executing it: the full one after marking every element dirty,
+// and the idle one with nothing changed, when elements replay their last recording. The rasterize case
+// executes one such frame with the software renderer instead of OpenGL, so no window or GL context is
+// needed.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/BMP.h"
+#include "../src/Benchmark.h"
+#include "../src/Bitmap.h"
+#include "../src/Effects.h"
+#include "../src/Project.h"
+#include "../src/RenderingContext.h"
+#include "../src/Screen.h"
+#include "../src/SoftwareRenderingEngine.h"
+#include "../src/ThreadPool.h"
+#include "../src/Workspace.h"
+
+namespace
+{
+    struct Size
+    {
+        int Width;
+        int Height;
+    };
+
+    struct Options
+    {
+        std::vector<Size> Sizes;
+
+        int Iterations = 10;
+        int Warmup = 2;
+        int Layers = 8;
+
+        std::string Filter;
+        std::string Output;
+    };
+
+    /**
+     * A benchmark case for one size. `Prepare` runs before every iteration, outside the timing.
+     */
+    struct Case
+    {
+        std::string Name;
+
+        std::function<void()> Prepare;
+        std::function<void()> Run;
+    };
+
+    struct Result
+    {
+        std::string Name;
+        Size ImageSize;
+
+        std::vector<double> Samples;
+    };
+
+    const char* TemporaryBMP = "yap_benchmark.tmp.bmp";
+    const char* TemporaryYAP = "yap_benchmark.tmp.yap";
+
+    /**
+     * Fills a bitmap with deterministic noise, with alpha spread over the whole range so compositing
+     * never hits the opaque or transparent shortcuts only.
+     */
+    yap::Bitmap CreateNoise(int width, int height, unsigned int seed)
+    {
+        yap::Bitmap bitmap(width, height);
+
+        std::mt19937 generator(seed);
+        std::vector<yap::ColorRGBA8> row(width);
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                uint32_t value = generator();
+                row[x] = yap::ColorRGBA8(value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, 64 + ((value >> 24) & 0xBF));
+            }
+
+            bitmap.WriteSpan(0, y, width, row.data());
+        }
+
+        return bitmap;
+    }
+
+    /**
+     * A solid image divided into cells by lines with a gap in each side, so a fill started in one cell
+     * winds through all of them, splitting into many spans.
+     */
+    yap::Bitmap CreateGrid(int width, int height)
+    {
+        yap::Bitmap bitmap(width, height);
+        bitmap.Clear(yap::ColorRGBA(255, 255, 255, 255));
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                if ((x % 32 == 0 && y % 32 != 16) || (y % 32 == 0 && x % 32 != 16))
+                {
+                    bitmap.SetPixel(x, y, yap::ColorRGBA(0, 0, 0, 255));
+                }
+            }
+        }
+
+        return bitmap;
+    }
+
+    /**
+     * Marks every element under `element` dirty, so the next frame draws all of them again.
+     */
+    void InvalidateTree(yap::Element& element)
+    {
+        element.Invalidate();
+
+        if (auto box = dynamic_cast<yap::Box*>(&element))
+        {
+            for (const auto& child : box->GetChildren())
+            {
+                InvalidateTree(*child);
+            }
+        }
+    }
+
+    std::shared_ptr<yap::Project> CreateProject(const Size& size, int layerCount)
+    {
+        auto project = std::make_shared<yap::Project>(size.Width, size.Height);
+
+        for (int i = 0; i < layerCount; ++i)
+        {
+            auto layer = project->CreateLayer(CreateNoise(size.Width, size.Height, 1000 + i));
+            layer->SetPosition(yap::Vec2((i % 3) * 16.0f - 16.0f, (i % 2) * 16.0f - 8.0f));
+        }
+
+        return project;
+    }
+
+    void AddEffectCase(std::vector<Case>& cases, const std::string& name, const std::shared_ptr<yap::Bitmap>& source, const std::shared_ptr<yap::Effect>& effect)
+    {
+        auto destination = std::make_shared<yap::Bitmap>();
+
+        cases.push_back({ "effect." + name, nullptr, [source, destination, effect]() {
+            effect->Apply(*source, *destination);
+        } });
+    }
+
+    std::vector<Case> CreateCases(const Size& size, const Options& options)
+    {
+        std::vector<Case> cases;
+
+        auto noise = std::make_shared<yap::Bitmap>(CreateNoise(size.Width, size.Height, 42));
+
+        // Scaling goes up by half in each direction, rotation keeps the size and turns 30 degrees.
+        auto scaled = std::make_shared<yap::Bitmap>(size.Width * 3 / 2, size.Height * 3 / 2);
+        auto rotated = std::make_shared<yap::Bitmap>(size.Width, size.Height);
+
+        cases.push_back({ "bitmap.scale.nearest", nullptr, [noise, scaled]() {
+            yap::Bitmap::Scale(*noise, *scaled, yap::ScalingMethod::NearestNeighbor);
+        } });
+
+        cases.push_back({ "bitmap.scale.bilinear", nullptr, [noise, scaled]() {
+            yap::Bitmap::Scale(*noise, *scaled, yap::ScalingMethod::Bilinear);
+        } });
+
+        cases.push_back({ "bitmap.rotate", nullptr, [noise, rotated, size]() {
+            yap::Vec2 center(size.Width / 2.0f, size.Height / 2.0f);
+            yap::Bitmap::Rotate(*noise, *rotated, 0.5235988f, center, yap::Vec2());
+        } });
+
+        AddEffectCase(cases, "brightness_contrast", noise, std::make_shared<yap::BrightnessContrastEffect>());
+        AddEffectCase(cases, "gamma", noise, std::make_shared<yap::GammaCorrectionEffect>());
+        AddEffectCase(cases, "grayscale", noise, std::make_shared<yap::GrayscaleEffect>());
+        AddEffectCase(cases, "sepia", noise, std::make_shared<yap::SepiaEffect>());
+        AddEffectCase(cases, "pixelate", noise, std::make_shared<yap::PixelateEffect>());
+        AddEffectCase(cases, "random_noise", noise, std::make_shared<yap::RandomNoiseEffect>());
+
+        auto blur = std::make_shared<yap::GaussianBlurEffect>();
+        blur->SetRadius(8.0f);
+
+        AddEffectCase(cases, "gaussian_blur", noise, blur);
+
+        auto grid = std::make_shared<yap::Bitmap>(CreateGrid(size.Width, size.Height));
+        auto fillLayer = std::make_shared<yap::Layer>(0, *grid);
+
+        cases.push_back({ "layer.fill", [fillLayer, grid]() {
+            fillLayer->SetBitmap(*grid);
+        }, [fillLayer]() {
+            fillLayer->Fill(yap::Vec2(8, 8), yap::ColorRGBA(255, 0, 0, 255), 0.1f);
+        } });
+
+        auto project = CreateProject(size, options.Layers);
+
+        cases.push_back({ "project.render_canvas", [project]() {
+            project->Invalidate();
+        }, [project]() {
+            project->RenderCanvas();
+        } });
+
+        cases.push_back({ "bmp.save", nullptr, [noise]() {
+            yap::BMP::Save(TemporaryBMP, *noise, true);
+        } });
+
+        cases.push_back({ "bmp.load", [noise]() {
+            yap::BMP::Save(TemporaryBMP, *noise, true);
+        }, []() {
+            yap::BMP::Load(TemporaryBMP);
+        } });
+
+        cases.push_back({ "project.save", nullptr, [project]() {
+            project->Save(TemporaryYAP);
+        } });
+
+        // Layers of a loaded project are decoded lazily, so the load is only done once all of them are.
+        // Each iteration loads into a fresh project, after the previous one released its mapping of the file.
+        auto loaded = std::make_shared<std::shared_ptr<yap::Project>>();
+
+        cases.push_back({ "project.load", [project, loaded]() {
+            loaded->reset();
+            project->Save(TemporaryYAP);
+
+            *loaded = std::make_shared<yap::Project>(0, 0);
+        }, [loaded]() {
+            (*loaded)->Load(TemporaryYAP);
+
+            for (const auto& layer : (*loaded)->GetLayers())
+            {
+                layer->GetBitmap();
+            }
+        } });
+
+        auto screen = std::make_shared<yap::Screen>();
+        auto context = std::make_shared<yap::RenderingContext>();
+
+        auto prepareScreen = [screen, context, size]() {
+            context->ClearCommands();
+
+            if (screen->Root->GetChildren().empty())
+            {
+                screen->Init();
+                screen->Root->AddChild(std::make_shared<yap::Workspace>());
+                screen->Resize(size.Width, size.Height);
+            }
+        };
+
+        // Every element is drawn again, as on the first frame or after a resize.
+        cases.push_back({ "screen.render.full", [screen, prepareScreen]() {
+            prepareScreen();
+            InvalidateTree(*screen->Root);
+        }, [screen, context]() {
+            screen->Render(*context);
+        } });
+
+        // Nothing changed since the previous frame, so the elements replay their recorded commands.
+        cases.push_back({ "screen.render.idle", prepareScreen, [screen, context]() {
+            screen->Render(*context);
+        } });
+
+        auto frameCommands = std::make_shared<yap::RenderingContext>();
+        auto frame = std::make_shared<yap::Bitmap>(size.Width, size.Height);
+        auto engine = std::make_shared<yap::SoftwareRenderingEngine>();
+
+        cases.push_back({ "screen.rasterize", [screen, frameCommands, size]() {
+            if (!frameCommands->GetCommands().empty())
+            {
+                return;
+            }
+
+            if (screen->Root->GetChildren().empty())
+            {
+                screen->Init();
+                screen->Root->AddChild(std::make_shared<yap::Workspace>());
+                screen->Resize(size.Width, size.Height);
+            }
+
+            screen->Render(*frameCommands);
+        }, [frameCommands, frame, engine]() {
+            engine->ExecuteCommands(frameCommands->GetCommands(), *frame);
+        } });
+
+        return cases;
+    }
+
+    double Percentile(const std::vector<double>& sorted, double percentile)
+    {
+        // Nearest-rank percentile: the smallest sample with at least `percentile` percent of the samples
+        // at or below it.
+        size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+        return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+    }
+
+    std::string EscapeJSON(const std::string& text)
+    {
+        std::string escaped;
+
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+            }
+
+            escaped += c;
+        }
+
+        return escaped;
+    }
+
+    void WriteReport(std::FILE* file, const Options& options, const std::vector<Result>& results)
+    {
+        std::fprintf(file, "{\n");
+        std::fprintf(file, "  \"config\": {\n");
+        std::fprintf(file, "    \"iterations\": %d,\n", options.Iterations);
+        std::fprintf(file, "    \"warmup\": %d,\n", options.Warmup);
+        std::fprintf(file, "    \"layers\": %d,\n", options.Layers);
+        std::fprintf(file, "    \"threads\": %d\n", static_cast<int>(yap::ThreadPool::GetShared().GetThreadCount()) + 1);
+        std::fprintf(file, "  },\n");
+        std::fprintf(file, "  \"results\": [");
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& result = results[i];
+
+            std::vector<double> sorted = result.Samples;
+            std::sort(sorted.begin(), sorted.end());
+
+            double mean = 0.0;
+
+            for (double sample : sorted)
+            {
+                mean += sample;
+            }
+
+            mean /= sorted.size();
+
+            double variance = 0.0;
+
+            for (double sample : sorted)
+            {
+                variance += (sample - mean) * (sample - mean);
+            }
+
+            variance /= sorted.size();
+
+            std::fprintf(file, "%s\n    {\n", i > 0 ? "," : "");
+            std::fprintf(file, "      \"name\": \"%s\",\n", EscapeJSON(result.Name).c_str());
+            std::fprintf(file, "      \"width\": %d,\n", result.ImageSize.Width);
+            std::fprintf(file, "      \"height\": %d,\n", result.ImageSize.Height);
+            std::fprintf(file, "      \"samples\": %d,\n", static_cast<int>(sorted.size()));
+            std::fprintf(file, "      \"min_ms\": %.4f,\n", sorted.front());
+            std::fprintf(file, "      \"mean_ms\": %.4f,\n", mean);
+            std::fprintf(file, "      \"stddev_ms\": %.4f,\n", std::sqrt(variance));
+            std::fprintf(file, "      \"p50_ms\": %.4f,\n", Percentile(sorted, 50.0));
+            std::fprintf(file, "      \"p90_ms\": %.4f,\n", Percentile(sorted, 90.0));
+            std::fprintf(file, "      \"p99_ms\": %.4f,\n", Percentile(sorted, 99.0));
+            std::fprintf(file, "      \"max_ms\": %.4f\n", sorted.back());
+            std::fprintf(file, "    }");
+        }
+
+        std::fprintf(file, "%s]\n}\n", results.empty() ? "" : "\n  ");
+    }
+
+    int ParseCount(const std::string& text, int minimum)
+    {
+        char* end = nullptr;
+        long value = std::strtol(text.c_str(), &end, 10);
+
+        if (text.empty() || *end != '\0' || value < minimum)
+        {
+            throw std::runtime_error("Invalid count '" + text + "'");
+        }
+
+        return static_cast<int>(value);
+    }
+
+    Size ParseSize(const std::string& text)
+    {
+        size_t separator = text.find('x');
+
+        if (separator == std::string::npos)
+        {
+            throw std::runtime_error("Invalid size '" + text + "', expected <width>x<height>");
+        }
+
+        return { ParseCount(text.substr(0, separator), 1), ParseCount(text.substr(separator + 1), 1) };
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+
+            if (i + 1 >= argc)
+            {
+                throw std::runtime_error("Missing value for " + argument);
+            }
+
+            std::string value = argv[++i];
+
+            if (argument == "-s")
+            {
+                options.Sizes.push_back(ParseSize(value));
+            }
+            else if (argument == "-n")
+            {
+                options.Iterations = ParseCount(value, 1);
+            }
+            else if (argument == "-w")
+            {
+                options.Warmup = ParseCount(value, 0);
+            }
+            else if (argument == "-l")
+            {
+                options.Layers = ParseCount(value, 1);
+            }
+            else if (argument == "-f")
+            {
+                options.Filter = value;
+            }
+            else if (argument == "-o")
+            {
+                options.Output = value;
+            }
+            else
+            {
+                throw std::runtime_error("Unknown option " + argument);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "yap_benchmark: %s\n", e.what());
+        std::fprintf(stderr, "Usage: yap_benchmark [-s <w>x<h>]... [-n <iterations>] [-w <warmup>] [-l <layers>] [-f <filter>] [-o <file>]\n");
+        return 2;
+    }
+
+    if (options.Sizes.empty())
+    {
+        options.Sizes = { { 640, 480 }, { 1920, 1080 } };
+    }
+
+    std::vector<Result> results;
+    int failures = 0;
+
+    for (const Size& size : options.Sizes)
+    {
+        for (const Case& benchmarkCase : CreateCases(size, options))
+        {
+            if (benchmarkCase.Name.find(options.Filter) == std::string::npos)
+            {
+                continue;
+            }
+
+            std::fprintf(stderr, "%-28s %5dx%-5d", benchmarkCase.Name.c_str(), size.Width, size.Height);
+
+            Result result = { benchmarkCase.Name, size, {} };
+
+            try
+            {
+                yap::Benchmark benchmark;
+
+                for (int iteration = 0; iteration < options.Warmup + options.Iterations; ++iteration)
+                {
+                    if (benchmarkCase.Prepare)
+                    {
+                        benchmarkCase.Prepare();
+                    }
+
+                    benchmark.Reset();
+                    benchmark.Start();
+
+                    benchmarkCase.Run();
+
+                    benchmark.Stop();
+
+                    if (iteration >= options.Warmup)
+                    {
+                        result.Samples.push_back(benchmark.GetTotalTime() * 1000.0);
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::fprintf(stderr, " failed: %s\n", e.what());
+
+                failures++;
+                continue;
+            }
+
+            std::vector<double> sorted = result.Samples;
+            std::sort(sorted.begin(), sorted.end());
+
+            std::fprintf(stderr, " p50 %10.3f ms\n", Percentile(sorted, 50.0));
+
+            results.push_back(result);
+        }
+    }
+
+    std::remove(TemporaryBMP);
+    std::remove(TemporaryYAP);
+
+    std::FILE* file = options.Output.empty() ? stdout : std::fopen(options.Output.c_str(), "w");
+
+    if (!file)
+    {
+        std::fprintf(stderr, "yap_benchmark: Unable to open %s for writing\n", options.Output.c_str());
+        return 1;
+    }
+
+    WriteReport(file, options, results);
+
+    if (file != stdout)
+    {
+        std::fclose(file);
+    }
+
+    return failures > 0 ? 1 : 0;
+}
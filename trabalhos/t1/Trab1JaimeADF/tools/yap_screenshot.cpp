@@ -0,0 +1,224 @@
+// Headless screenshot: builds the editor, optionally opens files in it like the file explorer does, and
+// rasterizes the settled frame into a BMP with the software renderer, without a window or GL context.
+//
+// Usage: yap_screenshot [options] [<input>...]
+//
+//   -o <file>      Output BMP (required).
+//   -s <w>x<h>     Window size (default 1280x720).
+//
+// A BMP input becomes a new layer and a .yap input replaces the project, in the order given. Frames are
+// rendered until the screen stops requesting them and every layer has loaded, so the screenshot shows
+// what the editor would show once idle. Like the editor, it loads its icons from Trab1JaimeADF/assets, so
+// run it from the folder that contains Trab1JaimeADF.
+//
+// Example: yap_screenshot -s 1920x1080 -o shot.bmp Trab1JaimeADF/images/demo.yap
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/BMP.h"
+#include "../src/Benchmark.h"
+#include "../src/Bitmap.h"
+#include "../src/Path.h"
+#include "../src/RenderingContext.h"
+#include "../src/Screen.h"
+#include "../src/SoftwareRenderingEngine.h"
+#include "../src/Workspace.h"
+
+namespace
+{
+    // Bounds the frames rendered while settling, in case something keeps requesting frames forever.
+    const int MaxFrames = 1000;
+
+    int ParseInt(const std::string& text)
+    {
+        char* end = nullptr;
+        long value = std::strtol(text.c_str(), &end, 10);
+
+        if (text.empty() || *end != '\0')
+        {
+            throw std::runtime_error("Invalid number '" + text + "'");
+        }
+
+        return static_cast<int>(value);
+    }
+
+    void OpenFile(yap::Project& project, const std::string& path)
+    {
+        std::string extension = yap::Path::Extension(path);
+
+        if (extension == "bmp" || extension == "BMP")
+        {
+            project.CreateLayer(yap::BMP::Load(path));
+        }
+        else if (extension == "yap" || extension == "YAP")
+        {
+            project.Load(path);
+        }
+        else
+        {
+            throw std::runtime_error("Unsupported input format: " + path);
+        }
+    }
+
+    /**
+     * Renders frames the way main.cpp does, only when the screen requests them, until it goes idle and no
+     * layer is loading anymore. Returns the number of frames rendered.
+     */
+    int Settle(yap::Screen& screen, yap::Project& project, yap::RenderingContext& context)
+    {
+        int frames = 0;
+
+        while (frames < MaxFrames)
+        {
+            if (screen.IsFrameRequested())
+            {
+                context.ClearCommands();
+                screen.Render(context);
+
+                frames++;
+            }
+            else if (project.IsLoading())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            else
+            {
+                // Layers that arrived while the last frame ran only get a timed request, so one more frame
+                // makes sure they are in the screenshot.
+                context.ClearCommands();
+                screen.Render(context);
+
+                return frames + 1;
+            }
+        }
+
+        return frames;
+    }
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr, "Usage: yap_screenshot -o <file> [-s <w>x<h>] [<input>...]\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string output;
+    std::vector<std::string> inputs;
+
+    int width = 1280;
+    int height = 720;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+
+            if (argument == "-h" || argument == "--help")
+            {
+                PrintUsage();
+                return 0;
+            }
+
+            if (argument == "-o" || argument == "-s")
+            {
+                if (i + 1 >= argc)
+                {
+                    throw std::runtime_error("Missing value for " + argument);
+                }
+
+                std::string value = argv[++i];
+
+                if (argument == "-o")
+                {
+                    output = value;
+                }
+                else
+                {
+                    size_t separator = value.find('x');
+
+                    if (separator == std::string::npos)
+                    {
+                        throw std::runtime_error("Invalid size '" + value + "'");
+                    }
+
+                    width = ParseInt(value.substr(0, separator));
+                    height = ParseInt(value.substr(separator + 1));
+
+                    if (width <= 0 || height <= 0)
+                    {
+                        throw std::runtime_error("Size must be positive");
+                    }
+                }
+            }
+            else if (!argument.empty() && argument[0] == '-')
+            {
+                throw std::runtime_error("Unknown option " + argument);
+            }
+            else
+            {
+                inputs.push_back(argument);
+            }
+        }
+
+        if (output.empty())
+        {
+            throw std::runtime_error("An output file is required");
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "yap_screenshot: %s\n\n", e.what());
+        PrintUsage();
+        return 2;
+    }
+
+    try
+    {
+        auto screen = std::make_shared<yap::Screen>();
+        auto workspace = std::make_shared<yap::Workspace>();
+
+        screen->Init();
+        screen->Root->AddChild(workspace);
+        screen->Resize(width, height);
+
+        for (const auto& input : inputs)
+        {
+            OpenFile(*workspace->GetProject(), input);
+        }
+
+        screen->RequestFrame();
+
+        yap::RenderingContext context;
+        int frames = Settle(*screen, *workspace->GetProject(), context);
+
+        yap::Bitmap frame(width, height);
+        yap::SoftwareRenderingEngine engine;
+
+        yap::Benchmark benchmark;
+        benchmark.Start();
+
+        engine.ExecuteCommands(context.GetCommands(), frame);
+
+        benchmark.Stop();
+
+        yap::BMP::Save(output, frame);
+
+        std::printf("%s: %dx%d after %d frames, rasterized in %.2f ms\n", output.c_str(), width, height, frames, benchmark.GetTotalTime() * 1000.0);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "yap_screenshot: %s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}